@@ -57,6 +57,26 @@
             2007.02.13 adapted to modified module tabscan
             2008.03.13 additional hyperedge evaluation added
             2008.03.24 additional target added (association groups)
+            2026.10.19 parallel support counting added (option -T)
+            2026.10.19 atomic counting in shared counters added (-T<0)
+            2026.10.19 64 bit transaction and support counts
+            2026.10.19 hash tree counting backend added (option -H)
+            2026.10.19 several levels per pass added (option -L)
+            2026.10.19 triangular array for pair counting (option -P)
+            2026.10.19 pair counting while reading added (option -F)
+            2026.10.19 hash filter for candidate pairs added (option -D)
+            2026.10.19 recoding of used items added (option -R)
+            2026.10.19 FP-growth search added (option -A)
+            2026.10.19 eclat search added (option -Ae)
+            2026.10.19 direct search for closed item sets (LCM)
+            2026.10.19 direct search for maximal item sets (GenMax)
+            2026.10.19 top k item sets and rules added (option -K)
+            2026.10.19 automatic choice of algorithm/options (option -X)
+            2026.10.19 counting with candidate id. lists (option -I)
+            2026.10.19 parallel mining of projections (option -M)
+            2026.10.19 class association rules added (option -Z)
+            2026.10.19 contrast sets of two groups added (target e)
+            2026.10.19 minimal counter width added (option -W)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -69,6 +89,12 @@
 #include "scan.h"
 #include "tract.h"
 #include "istree.h"
+#include "setrepo.h"
+#include "fpgrowth.h"
+#include "eclat.h"
+#include "lcm.h"
+#include "genmax.h"
+#include "parmine.h"
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -78,7 +104,7 @@
 ----------------------------------------------------------------------*/
 #define PRGNAME     "apriori"
 #define DESCRIPTION "find association rules with the apriori algorithm"
-#define VERSION     "version 4.35 (2008.03.24)        " \
+#define VERSION     "version 4.36 (2026.10.19)        " \
                     "(c) 1996-2008   Christian Borgelt"
 
 /* --- target types --- */
@@ -88,6 +114,7 @@
 #define TT_RULE        3        /* association rules */
 #define TT_HEDGE       4        /* association hyperedges */
 #define TT_GROUP       5        /* association groups */
+#define TT_CONTR       6        /* contrast sets (two groups) */
 
 /* --- error codes --- */
 #define E_OPTION     (-5)       /* unknown option */
@@ -101,7 +128,12 @@
 #define E_RULELEN   (-13)       /* invalid rule length */
 #define E_NOTAS     (-14)       /* no items or transactions */
 #define E_NOFREQ    (-15)       /* no frequent items */
-#define E_UNKNOWN   (-21)       /* unknown error */
+#define E_ALGO      (-21)       /* invalid search algorithm */
+#define E_TOPK      (-22)       /* top k search not possible */
+#define E_CARS      (-23)       /* class assoc. rules not possible */
+#define E_GROWTH    (-24)       /* invalid minimal growth rate */
+#define E_CONTR     (-25)       /* contrast sets not possible */
+#define E_UNKNOWN   (-26)       /* unknown error */
 
 #ifndef QUIET                   /* if not quiet version */
 #ifdef FFLUSH
@@ -113,11 +145,23 @@
 #define MSG(x)                  /* suppress messages */
 #endif
 
+#define LN_2          0.69314718055994530942  /* ln(2) */
 #define SEC_SINCE(t)  ((clock()-(t)) /(double)CLOCKS_PER_SEC)
 #define RECCNT(s)     (ts_reccnt(is_tabscan(s)) \
                       - ((ts_delim(is_tabscan(s)) == TS_REC) ? 1 : 0))
 #define BUFFER(s)     ts_buf(is_tabscan(s))
 
+/* --- automatic choice of algorithm and options --- */
+#define AU_COMPRESS   0.5       /* max. prefix tree size ratio for */
+                                /* a depth-first search */
+#define AU_LONG       24        /* min. avg. transaction size and */
+#define AU_RARE       4         /* max. avg. item frequency (relative */
+                                /* to the minimal support) for eclat */
+#define AU_NOTREE     0.95      /* min. prefix tree size ratio */
+                                /* for not using a transaction tree */
+#define AU_MANY       8192      /* min. number of items and */
+#define AU_SPARSE     0.01      /* max. density for minimizing memory */
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -130,6 +174,7 @@ static const char *ttypes[] = {
   /* TT_RULE     3 */  "rule",
   /* TT_HEDGE    4 */  "hyperedge",
   /* TT_GROUP    5 */  "group",
+  /* TT_CONTR    6 */  "contrast set",
 };
 
 /* --- error messages --- */
@@ -157,7 +202,15 @@ static const char *errmsgs[] = {
   /* E_UNKAPP  -19 */  "file %s, record %d: "
                          "unknown appearance indicator %s\n",
   /* E_FLDCNT  -20 */  "file %s, record %d: too many fields\n",
-  /* E_UNKNOWN -21 */  "unknown error\n"
+  /* E_ALGO    -21 */  "invalid search algorithm '%c'\n",
+  /* E_TOPK    -22 */  "top k search needs target s or r "
+                         "and the apriori algorithm (without -M)\n",
+  /* E_CARS    -23 */  "class association rules need target r "
+                         "and head only items\n",
+  /* E_GROWTH  -24 */  "invalid minimal growth rate %g\n",
+  /* E_CONTR   -25 */  "contrast sets need two head only items "
+                         "and the apriori algorithm (without -M)\n",
+  /* E_UNKNOWN -26 */  "unknown error\n"
 };
 #endif
 
@@ -173,6 +226,17 @@ static TATREE  *tatree  = NULL; /* transaction tree */
 static ISTREE  *istree  = NULL; /* item set tree */
 static FILE    *in      = NULL; /* input  file */
 static FILE    *out     = NULL; /* output file */
+static char    *sep     = " ";  /* item separator for output */
+static char    *fmt     = "%.1f";   /* output format for supp./conf. */
+static int     sout     = 1;    /* flag for abs./rel. support output */
+static int     ext      = 0;    /* flag for extended support output */
+static int     aval     = 0;    /* flag for add. eval. measure value */
+static int     c2scf    = 0;    /* flag for conv. to scanable form */
+static int     arem     = 0;    /* additional rule evaluation measure */
+static double  minval   = 0.1;  /* minimal evaluation measure value */
+static double  smax     = 1.0;  /* maximal support    (in percent) */
+static SUPP    tacnt;           /* number of transactions */
+static char    buf[4*TS_SIZE+4];/* buffer for formatting */
 
 /*----------------------------------------------------------------------
   Main Functions
@@ -231,9 +295,212 @@ static void error (int code, ...)
 
 /*--------------------------------------------------------------------*/
 
+static void _setout (const int *set, int k, SUPP frq, double val)
+{                               /* --- print a frequent item set */
+  int        i;                 /* loop variable */
+  const char *name;             /* buffer for item names */
+
+  for (i = 0; i < k; i++) {     /* traverse the set's items */
+    name = is_name(itemset, set[i]);
+    if (c2scf) { sc_format(buf, name, 0); name = buf; }
+    fputs(name, out);           /* print the name of the next item */
+    fputs((i < k-1) ? sep : " ", out);
+  }                             /* print a separator */
+  fputs(" (", out);             /* print the item set's support */
+  if (sout & 1) { fprintf(out, fmt, (frq/(double)tacnt) *100);
+                  if (sout & 2) fputc('/', out); }
+  if (sout & 2) { fprintf(out, SUPP_FMT, frq); }
+  if (ext) {                    /* if to print the extended support */
+    frq = tas_occur(taset, set, k);
+    fputs(", ", out);           /* get the number of occurrences */
+    fprintf(out, fmt, (frq/(double)tacnt) *100);
+    if (sout & 2) fprintf(out, "/" SUPP_FMT, frq);
+  }                             /* print the extended support data */
+  if (aval) { fputs(", ", out); fprintf(out, fmt, val *100); }
+  fputs(")\n", out);            /* print the add. eval. measure */
+}  /* _setout() */              /* and terminate the support output */
+
+/*--------------------------------------------------------------------*/
+
+static int _report (const int *set, int cnt, SUPP supp, void *data)
+{                               /* --- report a found item set */
+  int    i;                     /* loop variable */
+  double dev = 0;               /* deviation from indep. occurrence */
+
+  if (supp > smax) return 0;    /* check against maximal support */
+  for (i = cnt; --i >= 0; )     /* skip sets with items to ignore */
+    if (is_getapp(itemset, set[i]) == IST_IGNORE) return 0;
+  if (arem == EM_DIFF) {        /* if logarithm of support quotient */
+    dev = log(supp);            /* (same as in the item set tree) */
+    for (i = cnt; --i >= 0; ) dev -= log(is_getfrq(itemset, set[i]));
+    dev = (dev +(cnt-1) *log(tacnt)) *(0.01/LN_2);
+    if (dev < minval) return 0; /* if the value of the additional */
+  }                             /* measure is too low, skip the set */
+  _setout(set, cnt, supp, dev); /* print the item set */
+  (*(int*)data)++;              /* and count it */
+  return 0;                     /* return 'ok' */
+}  /* _report() */
+
+/*--------------------------------------------------------------------*/
+
+static int _store (const int *set, int cnt, SUPP supp, void *data)
+{                               /* --- store a found item set */
+  return sr_add((SETREPO*)data, set, cnt, supp);
+}  /* _store() */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP _lookup (const int *set, int cnt, void *data)
+{                               /* --- get the support of an item set */
+  return sr_get((SETREPO*)data, set, cnt);
+}  /* _lookup() */
+
+/*--------------------------------------------------------------------*/
+
+static int _apriori (TASET *tas, SUPP supp, int min, int max,
+                     ISREPFN *report, void *data)
+{                               /* --- find frequent item sets */
+  int    i, k, n;               /* loop variables, number of items */
+  int    r = 0;                 /* result of the search */
+  int    *s, *set;              /* transaction, buffer for a set */
+  SUPP   frq, *frqs;            /* support of a set, item frequencies */
+  double val;                   /* (dummy for add. evaluation value) */
+  ISTREE *ist;                  /* item set tree for the search */
+
+  n    = is_cnt(itemset);       /* get the number of items */
+  frqs = (SUPP*)calloc((size_t)n, sizeof(SUPP) +sizeof(int));
+  if (!frqs) return -1;         /* create the item vectors */
+  set  = (int*)(frqs +n);       /* (frequencies, set buffer) */
+  ist  = ist_create(itemset, IST_BOTH, supp, 1.0);
+  if (!ist) { free(frqs); return -1; }
+  for (i = tas_cnt(tas); --i >= 0; )
+    for (s = tas_tract(tas, i), k = tas_tsize(tas, i); --k >= 0; )
+      frqs[s[k]]++;             /* determine the item frequencies */
+  for (i = 0; i < n; i++)       /* in the given transactions and */
+    ist_setcnt(ist, i, frqs[i]);/* set them in the item set tree */
+  while (ist_height(ist) < max) {
+    k = ist_addlvl(ist);        /* while max. height is not reached, */
+    if (k <  0) { r = -1; break; }  /* add a level to the tree */
+    if (k != 0) break;          /* if no level was added, abort */
+    ist_counts(ist, tas);       /* count the transactions */
+  }
+  if ((r == 0) && (ist_init(ist, min, EM_NONE, 1) < 0))
+    r = -1;                     /* initialize the extraction */
+  while (r == 0) {              /* extract the item sets */
+    k = ist_set(ist, set, &frq, &val);
+    if (k <= 0) break;          /* get the next frequent item set */
+    if (report(set, k, frq, data) < 0) r = -1;
+  }                             /* and report it */
+  ist_delete(ist); free(frqs);  /* delete the item set tree */
+  return r;                     /* and the item vectors */
+}  /* _apriori() */
+
+/*--------------------------------------------------------------------*/
+
+static int _mine (int algo, int par, SUPP supp, int min, int max,
+                  ISREPFN *report, void *data)
+{                               /* --- find frequent item sets */
+  PMMINEFN *mine;               /* search function for a t.a. set */
+
+  mine = (algo == 'e') ? ecl_mine     /* get the search function */
+       : (algo == 'f') ? fpg_mine : _apriori;
+  if (par > 0)                  /* if to mine projections in parallel */
+    return pm_mine(taset, supp, min, max, par, mine, report, data);
+  return mine(taset, supp, min, max, report, data);
+}  /* _mine() */                /* search with the chosen algorithm */
+
+/*--------------------------------------------------------------------*/
+
+static int _topk (SUPP *heap, int *cnt, int k, int target, int lvl)
+{                               /* --- raise support for top k */
+  int  i, c, n;                 /* loop variables, size of set/rule */
+  int  *set;                    /* buffer for an item set/rule */
+  SUPP frq;                     /* support of an item set/rule */
+
+  assert(heap && cnt && (k > 0) && (lvl > 0));
+  if (lvl > ist_height(istree)) /* if there are no new sets, */
+    return 0;                   /* there is nothing to do */
+  if (ist_init(istree, lvl, arem, minval) < 0)
+    return -1;                  /* init. the extraction of new sets */
+  set = is_tract(itemset);      /* get the transaction buffer */
+  while (1) {                   /* traverse the new sets/rules */
+    n = (target == TT_RULE)     /* get the next rule or item set */
+      ? ist_rule(istree, set, &frq, NULL, NULL, NULL)
+      : ist_set (istree, set, &frq, NULL);
+    if (n <= 0) break;          /* check for the end of the level */
+    if (frq > smax) continue;   /* check against maximal support */
+    if (*cnt < k) {             /* if the heap is not yet full, */
+      for (i = (*cnt)++; i > 0; i = c) {  /* insert the support */
+        c = (i-1) >> 1;         /* (sift it up from the end) */
+        if (heap[c] <= frq) break;
+        heap[i] = heap[c];      /* shift larger parents down */
+      }                         /* to make room for the support */
+      heap[i] = frq; continue;  /* store the support in the heap */
+    }                           /* and go to the next set/rule */
+    if (frq <= heap[0]) continue;  /* skip sets below the k-th best */
+    for (i = 0; (c = i+i+1) < k; i = c) {
+      if ((c+1 < k) && (heap[c+1] < heap[c])) c++;
+      if (heap[c] >= frq) break;/* replace the smallest support */
+      heap[i] = heap[c];        /* and sift the new support down */
+    }                           /* (shift smaller children up) */
+    heap[i] = frq;              /* store the support in the heap */
+  }
+  if (*cnt >= k)                /* if k sets/rules have been found, */
+    ist_setsupp(istree, heap[0]);  /* raise the minimal support */
+  return 0;                     /* to that of the k-th best one */
+}  /* _topk() */
+
+/*--------------------------------------------------------------------*/
+
+static int _auto (int n, SUPP smin, int target, int sort, int algo,
+                  int fixed, int *tree, int *mode)
+{                               /* --- choose algorithm and options */
+  int    i;                     /* loop variable */
+  double total;                 /* total number of items */
+  double avg, dens, frq;        /* statistics of the transactions */
+  double comp = -1, desc;       /* prefix tree size ratios */
+
+  assert(taset && (n > 0) && tree && mode);
+  total = (tas_total(taset) > 0) ? tas_total(taset) : 1;
+  avg   = total /tas_cnt(taset);/* compute the average size, */
+  dens  = avg /n;               /* the density and the average item */
+  frq   = total /(n *(double)((smin > 0) ? smin : 1)); /* frequency */
+  if (sort > 0)                 /* relative to the minimal support */
+    for (i = tas_cnt(taset); --i >= 0; )
+      v_intrev(tas_tract(taset, i), tas_tsize(taset, i));
+  tas_sort(taset, 0);           /* compute the size ratio of a prefix */
+  desc = tas_ptsize(taset) /total;   /* tree with the items in */
+  if (sort > 0)                 /* descending order of frequency */
+    for (i = tas_cnt(taset); --i >= 0; )
+      v_intrev(tas_tract(taset, i), tas_tsize(taset, i));
+  if (!fixed                    /* if the algorithm is not fixed */
+  &&  (desc <= AU_COMPRESS)) {  /* and the transactions compress well */
+    if ((avg >= AU_LONG) || (frq < AU_RARE))
+      algo = 'e';               /* use eclat for long transactions */
+    else if ((target != TT_CLSET) && (target != TT_MFSET))
+      algo = 'f';               /* and items with low support, */
+  }                             /* FP-growth otherwise (but not for */
+  if (algo == 'a') {            /* closed and maximal item sets) */
+    if (sort <= 0) comp = desc; /* compute the size ratio */
+    else { tas_sort(taset, 0);  /* of the transaction tree */
+           comp = tas_ptsize(taset) /total; }
+    if (comp > AU_NOTREE)       /* if the tree does not compress */
+      *tree = 0;                /* the transactions, do not build it */
+    if ((n >= AU_MANY) && (dens <= AU_SPARSE))
+      *mode |= IST_MEMOPT;      /* for many items in sparse data */
+  }                             /* minimize the memory usage */
+  MSG(fprintf(stderr, "[density %.3f, size %.1f/%d, frequency %.1f, "
+              "tree %.3f", dens, avg, tas_max(taset), frq, desc));
+  if (comp >= 0) { MSG(fprintf(stderr, "/%.3f", comp)); }
+  MSG(fprintf(stderr, "] "));   /* print the statistics */
+  return algo;                  /* return the search algorithm */
+}  /* _auto() */
+
+/*--------------------------------------------------------------------*/
+
 int main (int argc, char *argv[])
 {                               /* --- main function */
-  int    i, k = 0, n;           /* loop variables, counters */
+  int    i, k = 0, n, l;        /* loop variables, counters */
   char   *s;                    /* to traverse the options */
   char   **optarg = NULL;       /* option argument */
   char   *fn_in   = NULL;       /* name of input  file */
@@ -245,13 +512,17 @@ int main (int argc, char *argv[])
   char   *comment = NULL;       /* comment indicators */
   char   *used    = NULL;       /* item usage vector */
   double supp     = 0.1;        /* minimal support    (in percent) */
-  double smax     = 1.0;        /* maximal support    (in percent) */
   double conf     = 0.8;        /* minimal confidence (in percent) */
   int    mode     = IST_BODY;   /* search mode (rule support def.) */
+  int    cls      = 0;          /* number of classes (CAR mode) */
+  double grow     = 2;          /* minimal growth rate */
+  int    grp[2];                /* group labels of contrast sets */
+  SUPP   gsz[2];                /* sizes of the two groups */
+  SUPP   gmin[2];               /* minimal supports in the groups */
+  SUPP   gsupp[2];              /* supports of a contrast set */
+  double grel[2];               /* relative supports in the groups */
   int    target   = 'r';        /* target type (sets/rules/h.edges) */
-  int    arem     = 0;          /* additional rule evaluation measure */
   int    lift     = 0;          /* flag for printing the lift */
-  double minval   = 0.1;        /* minimal evaluation measure value */
   double lftval   = 0;          /* lift value (confidence/prior) */
   int    minlen   = 1;          /* minimal rule length */
   int    maxlen   = INT_MAX;    /* maximal rule length */
@@ -260,18 +531,27 @@ int main (int argc, char *argv[])
   double filter   = 0.1;        /* item usage filtering parameter */
   int    tree     = 1;          /* flag for transaction tree */
   int    heap     = 1;          /* flag for heap sort vs. quick sort */
-  int    c2scf    = 0;          /* flag for conv. to scanable form */
-  char   *sep     = " ";        /* item separator for output */
-  char   *fmt     = "%.1f";     /* output format for support/conf. */
-  int    sout     = 1;          /* flag for abs./rel. support output */
-  int    ext      = 0;          /* flag for extended support output */
-  int    aval     = 0;          /* flag for add. eval. measure value */
+  int    thcnt    = 1;          /* number of threads for counting */
+  int    cwd      = 16;         /* minimal counter width in bits */
+  int    lpp      = 1;          /* number of levels per counting pass */
+  int    fused    = 0;          /* flag for counting pairs in reading */
+  int    dhp      = 0;          /* number of hash buckets for pairs */
+  int    recode   = 0;          /* flag for recoding the used items */
+  int    algo     = 'a';        /* search algorithm (e.g. FP-growth) */
+  int    direct   = 0;          /* flag for reporting sets directly */
   int    maxcnt   = 0;          /* maximal number of items per set */
-  int    tacnt;                 /* number of transactions */
-  int    frq;                   /* frequency of an item set */
+  int    topk     = 0;          /* number of best sets/rules to find */
+  int    par      = 0;          /* number of threads for projections */
+  int    autom    = 0;          /* flag for automatic choice */
+  char   given[256];            /* flags for the given options */
+  int    hcnt     = 0;          /* number of keys in the heap */
+  int    lvls     = 0;          /* number of levels in the heap */
+  SUPP   *best    = NULL;       /* min. heap of the best supports */
+  SUPP   smin;                  /* minimal support of an item */
+  SUPP   frq;                   /* frequency of an item set */
   int    *map, *set;            /* identifier map, item set */
+  SETREPO *repo;                /* repository of found item sets */
   const  char *name;            /* buffer for item names */
-  static char buf[4*TS_SIZE+4]; /* buffer for formatting */
   clock_t     t, tt, tc, x;     /* timer for measurements */
 
   #ifndef QUIET                 /* if not quiet version */
@@ -289,7 +569,8 @@ int main (int argc, char *argv[])
            "         (s: item sets, c: closed item sets,"
                     " m: maximal item sets,\n"
            "          r: association rules,"
-                    " h: association hyperedges)\n");
+                    " h: association hyperedges,\n"
+           "          e: contrast sets of two groups)\n");
     printf("-m#      minimal number of items per set/rule/hyperedge "
                     "(default: %d)\n", minlen);
     printf("-n#      maximal number of items per set/rule/hyperedge "
@@ -302,6 +583,14 @@ int main (int argc, char *argv[])
                     "(default: %g%%)\n", conf *100);
     printf("-o       use original definition of the support of a rule "
                     "(body & head)\n");
+    printf("-Z       find only class association rules "
+                    "(heads: head only items)\n");
+    printf("-G#      minimal growth rate of a contrast set "
+                    "(default: %g)\n", grow);
+    printf("         (the groups are given by two head only items, "
+                    "the supports\n"
+           "          of contrast sets are relative to the group "
+                    "sizes)\n");
     printf("-k#      item separator for output "
                     "(default: \"%s\")\n", sep);
     printf("-p#      output format for support/confidence "
@@ -335,6 +624,45 @@ int main (int argc, char *argv[])
                     "(default: heapsort)\n");
     printf("-z       minimize memory usage "
                     "(default: maximize speed)\n");
+    printf("-A#      search algorithm (default: apriori)\n"
+           "         (a: apriori, f: FP-growth, e: eclat)\n");
+    printf("-H       count supports with a hash tree "
+                    "(default: item set tree)\n");
+    printf("-L#      number of levels to count per pass "
+                    "(default: %d)\n", lpp);
+    printf("-P       count item pairs in a triangular array\n");
+    printf("-F       count item pairs while reading the transactions\n");
+    printf("-D#      number of hash buckets for filtering pairs "
+                    "(default: %d)\n", dhp);
+    printf("-R       recode the used items after counting pairs\n");
+    printf("-I       count with candidate identifier lists "
+                    "(AprioriHybrid)\n"
+           "         (used once they are smaller than the "
+                    "transactions)\n");
+    printf("-K#      find only the k sets/rules with the highest "
+                    "support (default: all)\n"
+           "         (the minimal support is raised automatically,\n"
+           "          -s gives a lower bound, default then: 0)\n");
+    printf("-X       choose the search algorithm and options "
+                    "automatically\n"
+           "         (from statistics of the transactions; "
+                    "given options are kept)\n");
+    printf("-T#      number of threads for support counting "
+                    "(default: %d)\n", thcnt);
+    printf("         (<0: count only in shared counters, "
+                    "with atomic increments)\n");
+    printf("-W#      minimal width of the support counters in bits "
+                    "(default: %d)\n", cwd);
+    printf("         (16: choose the width from the number of "
+                    "transactions;\n"
+           "          32 or 64: use at least this width)\n");
+    printf("-M#      number of threads for mining projections "
+                    "(default: %d)\n", par);
+    printf("         (0: do not split the search; otherwise the item "
+                    "sets are split\n"
+           "          by their first item and each part is mined "
+                    "with the chosen\n"
+           "          algorithm on the projected transactions)\n");
     printf("-b/f/r#  blank characters, field and record separators\n"
            "         (default: \" \\t\\r\", \" \\t\", \"\\n\")\n");
     printf("-C#      comment characters (default: \"#\")\n");
@@ -347,11 +675,13 @@ int main (int argc, char *argv[])
   #endif  /* #ifndef QUIET */
 
   /* --- evaluate arguments --- */
+  memset(given, 0, sizeof(given));
   for (i = 1; i < argc; i++) {  /* traverse arguments */
     s = argv[i];                /* get option argument */
     if (optarg) { *optarg = s; optarg = NULL; continue; }
     if ((*s == '-') && *++s) {  /* -- if argument is an option */
       while (*s) {              /* traverse options */
+        given[(unsigned char)*s] = 1;   /* note the option */
         switch (*s++) {         /* evaluate switches */
           case '!': help();                         break;
           case 't': target = (*s) ? *s++ : 'r';     break;
@@ -361,6 +691,8 @@ int main (int argc, char *argv[])
           case 'S': smax   = 0.01*strtod(s, &s);    break;
           case 'c': conf   = 0.01*strtod(s, &s);    break;
           case 'o': mode  |= IST_BOTH;              break;
+          case 'Z': mode  |= IST_CARS;              break;
+          case 'G': grow   =      strtod(s, &s);    break;
           case 'k': optarg = &sep;                  break;
           case 'p': optarg = &fmt;                  break;
           case 'x': ext    = 1;                     break;
@@ -376,6 +708,19 @@ int main (int argc, char *argv[])
           case 'h': tree   = 0;                     break;
           case 'j': heap   = 0;                     break;
           case 'z': mode  |= IST_MEMOPT;            break;
+          case 'A': algo   = (*s) ? *s++ : 'a';     break;
+          case 'H': mode  |= IST_HASH;              break;
+          case 'P': mode  |= IST_PAIRS;             break;
+          case 'F': fused  = 1;                     break;
+          case 'D': dhp    = (int)strtol(s, &s, 0); break;
+          case 'R': recode = 1;                     break;
+          case 'I': mode  |= IST_TIDS;              break;
+          case 'K': topk   = (int)strtol(s, &s, 0); break;
+          case 'X': autom  = 1;                     break;
+          case 'L': lpp    = (int)strtol(s, &s, 0); break;
+          case 'T': thcnt  = (int)strtol(s, &s, 0); break;
+          case 'W': cwd    = (int)strtol(s, &s, 0); break;
+          case 'M': par    = (int)strtol(s, &s, 0); break;
           case 'b': optarg = &blanks;               break;
           case 'f': optarg = &fldseps;              break;
           case 'r': optarg = &recseps;              break;
@@ -405,8 +750,25 @@ int main (int argc, char *argv[])
     case 'r': target = TT_RULE;              break;
     case 'h': target = TT_HEDGE;             break;
     case 'g': target = TT_GROUP;             break;
+    case 'e': target = TT_CONTR;             break;
     default : error(E_TARGET, (char)target); break;
   }
+  switch (algo) {               /* check the search algorithm */
+    case 'a': case 'f': case 'e':            break;
+    default : error(E_ALGO, (char)algo);     break;
+  }
+  if ((topk > 0)                /* check the top k search */
+  &&  (((target != TT_SET) && (target != TT_RULE))
+  ||   (algo != 'a') || (par > 0)))
+    error(E_TOPK);              /* (sets/rules with apriori only) */
+  if ((mode & IST_CARS) && (target != TT_RULE)
+  &&  (target != TT_CONTR))     /* check class association rules */
+    error(E_CARS);              /* (contrast sets also use classes) */
+  if ((target == TT_CONTR) && ((algo != 'a') || (par > 0)))
+    error(E_CONTR);             /* check contrast set mining */
+  if (grow < 1) error(E_GROWTH, grow);
+  if ((topk > 0) && !given['s'])/* for a top k search the support */
+    supp = 0;                   /* is raised while sets are found */
   if (supp > 1)                 /* check the minimal support */
     error(E_SUPP, supp);        /* (< 0: absolute number) */
   if ((conf  <  0) || (conf > 1))
@@ -425,14 +787,30 @@ int main (int argc, char *argv[])
   }
   if (target <= TT_MFSET) {     /* in item set mode neutralize */
     mode |= IST_BOTH; conf = 1;}/* rule specific settings */
+  if (target == TT_CONTR) {     /* for contrast sets the group labels */
+    mode |= IST_BOTH|IST_CARS|IST_CONTR; conf = 1;  /* are classes */
+    mode &= ~(IST_PAIRS|IST_TIDS); fused = 0; dhp = 0;
+  }                             /* (all counters of the labels must */
+                                /* be kept, even if infrequent) */
   if (arem == EM_NONE)          /* if no add. rule eval. measure, */
     aval = 0;                   /* clear the corresp. output flag */
   if ((filter <= -1) || (filter >= 1)) filter = 0;
+  if ((algo != 'a')             /* if not to use the apriori algorithm */
+  ||  (par > 0)) {              /* or to mine projections, */
+    load = 1; tree = 0;         /* the transactions must be loaded, */
+    filter = 0; recode = 0;     /* but no transaction tree is needed */
+    fused  = 0; dhp    = 0;     /* and no counting options apply */
+    lpp    = 1; mode  &= ~(IST_HASH|IST_PAIRS);
+  }
 
   /* --- create item set and transaction set --- */
   itemset = is_create(-1);      /* create an item set and */
   if (!itemset) error(E_NOMEM); /* set the special characters */
   is_chars(itemset, blanks, fldseps, recseps, comment);
+  if (fused && (is_pairs(itemset) != 0))
+    error(E_NOMEM);             /* prepare pair counting */
+  if ((dhp > 0) && (is_dhp(itemset, dhp) != 0))
+    error(E_NOMEM);             /* prepare pair hashing */
   if (load) {                   /* if to load the transactions */
     taset = tas_create(itemset);
     if (!taset) error(E_NOMEM); /* create a transaction set */
@@ -479,10 +857,23 @@ int main (int argc, char *argv[])
   }                             /* clear the file variable */
   n     = is_cnt(itemset);      /* get the number of items */
   tacnt = is_gettac(itemset);   /* and the number of transactions */
-  MSG(fprintf(stderr, "[%d item(s), %d transaction(s)]", n, tacnt));
+  MSG(fprintf(stderr, "[%d item(s), " SUPP_FMT " transaction(s)]",
+              n, tacnt));
   MSG(fprintf(stderr, " done [%.2fs].", SEC_SINCE(t)));
   if ((n <= 0) || (tacnt <= 0)) error(E_NOTAS);
   MSG(fprintf(stderr, "\n"));   /* check for at least one transaction */
+  if (target == TT_CONTR) {     /* if to find contrast sets */
+    for (k = i = 0; i < n; i++){/* find the group labels */
+      if (is_getapp(itemset, i) != APP_HEAD) continue;
+      if (k < 2) grp[k] = i;    /* (head only items, the one listed */
+      k++;                      /* first in the appearances file */
+    }                           /* is the label of group 1) */
+    if (k != 2) error(E_CONTR); /* there must be exactly two groups */
+    for (i = 0; i < 2; i++) {   /* get the group sizes and supports */
+      gsz[i]  = is_getfrq(itemset, grp[i]);
+      gmin[i] = (SUPP)((supp >= 0) ? ceil(gsz[i] *supp) : ceil(-100 *supp));
+    }                           /* (relative to the group sizes) */
+  }
   if (supp >= 0)                /* if relative support is given */
     supp = ceil(tacnt *supp);   /* compute absolute support */
   else {                        /* if absolute support is given, */
@@ -490,25 +881,71 @@ int main (int argc, char *argv[])
     if (!(sout & 2)) sout = 2;  /* switch to absolute support output */
   }                             /* do the same with the max. support */
   smax = floor(((smax >= 0) ? tacnt : -100) *smax);
+  if (target == TT_CONTR)       /* for contrast sets use the smaller */
+    supp = (gmin[0] < gmin[1]) ? gmin[0] : gmin[1];  /* group support */
 
   /* --- sort and recode items --- */
   MSG(fprintf(stderr, "filtering, sorting and recoding items ... "));
   t   = clock();                /* start the timer */
   map = (int*)malloc(is_cnt(itemset) *sizeof(int));
   if (!map) error(E_NOMEM);     /* create an item identifier map */
-  k = (int)((mode & IST_HEAD) ? supp : ceil(supp *conf));
-  n = is_recode(itemset, k, sort, map);
+  smin = (SUPP)((mode & IST_HEAD) ? supp : ceil(supp *conf));
+  n = is_recode(itemset, smin, sort, map);
   if (taset) {                  /* sort and recode the items and */
     tas_recode(taset, map,n);   /* recode the loaded transactions */
     maxcnt = tas_max(taset);    /* get the new maximal t.a. size */
   }                             /* (may be smaller than before) */
+  if (mode & IST_CARS) {        /* if class association rules */
+    if (target == TT_CONTR) {   /* get the new codes of the labels */
+      grp[0] = map[grp[0]]; grp[1] = map[grp[1]]; }
+    for (i = k = 0; i < n; i++) /* traverse the frequent items */
+      if (is_getapp(itemset, i) != APP_HEAD) {
+        is_setapp(itemset, i, APP_BODY); map[i] = k++; }
+    cls = n -k;                 /* all items that are not classes */
+    if (cls <= 0) error(E_CARS);/* (head only items) are body only */
+    if ((target == TT_CONTR) && (cls != 2)) error(E_CONTR);
+    for (i = 0; i < n; i++)     /* and are coded first, the classes */
+      if (is_getapp(itemset, i) == APP_HEAD) map[i] = k++;
+    if ((target == TT_CONTR) && (map[grp[0]] > map[grp[1]])) {
+      i = map[grp[0]]; map[grp[0]] = map[grp[1]]; map[grp[1]] = i; }
+    for (i = n; i < is_cnt(itemset); i++) map[i] = i;
+    is_remap(itemset, map);     /* are coded last, so that they are */
+    if (taset) tas_recode(taset, map, n);
+  }                             /* counted at the end of each node */
   free(map);                    /* delete the item identifier map */
-  MSG(fprintf(stderr, "[%d item(s)] ", n));
+  MSG(fprintf(stderr, "[%d item(s)", n));
+  if (cls > 0) { MSG(fprintf(stderr, ", %d class(es)", cls)); }
+  MSG(fprintf(stderr, "] "));
   MSG(fprintf(stderr, "done [%.2fs].", SEC_SINCE(t)));
   if (n <= 0) error(E_NOFREQ);  /* print a log message and */
   MSG(fprintf(stderr, "\n"));   /* check the number of items */
+
+  /* --- choose algorithm and options --- */
+  if (autom && taset) {         /* if to choose options automatically */
+    MSG(fprintf(stderr, "analyzing transactions ... "));
+    t = clock();                /* start the timer */
+    k = given['A'] || given['K'] || given['H'] || given['L']
+     || given['P'] || given['F'] || given['D'] || given['R']
+     || given['I'] || given['T'] || given['M']
+     || (target == TT_CONTR);   /* (these need the given algorithm) */
+    algo = _auto(n, smin, target, sort, algo, k, &tree, &mode);
+    MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
+    MSG(fprintf(stderr, "chosen options: -A%c%s%s\n", algo,
+                (tree || (algo != 'a'))  ? "" : " -h",
+                (mode & IST_MEMOPT)     ? " -z" : ""));
+    if (algo != 'a') {          /* a depth-first search needs */
+      tree = 0; filter = 0; }   /* no transaction tree or filtering */
+  }                             /* (an explicitly chosen algorithm */
+                                /* or counting options are kept) */
+  direct = (par > 0)            /* check whether to report directly */
+         ? (target == TT_SET)   /* (closed and maximal sets only */
+         : (algo != 'a')        /* without a limit for the set size */
+        && ((target == TT_SET)  /* and not with projections) */
+        ||  ((target <= TT_MFSET) && (maxlen >= maxcnt)));
   if (maxlen > maxcnt)          /* clamp the set/rule length */
     maxlen = maxcnt;            /* to the maximum set size */
+  else if (target == TT_CONTR)  /* for contrast sets the sets with */
+    maxlen++;                   /* a group label must be counted */
 
   /* --- create a transaction tree --- */
   tt = 0;                       /* init. the tree construction time */
@@ -517,7 +954,8 @@ int main (int argc, char *argv[])
     t = clock();                /* start the timer */
     tatree = tat_create(taset, heap); 
     if (!tatree) error(E_NOMEM);/* create a transaction tree */
-    if (filter == 0) {          /* if a tree rebuild is not needed, */
+    if ((filter == 0) && !recode    /* if no rebuild is needed */
+    &&  !(mode & IST_TIDS)) {   /* and no id. lists are built, */
       tas_delete(taset, 0); taset = NULL; }  /* delete transactions */
     tt = clock() -t;            /* note the time for the construction */
     MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
@@ -525,25 +963,95 @@ int main (int argc, char *argv[])
 
   /* --- create an item set tree --- */
   t = clock(); tc = 0;          /* start the timer */
-  istree = ist_create(itemset, mode, (int)supp, conf);
+  if      (cwd > 32) mode |= IST_CNT64; /* enforce a minimal */
+  else if (cwd > 16) mode |= IST_CNT32; /* counter width */
+  istree = ist_create(itemset, mode, (SUPP)supp, conf);
   if (!istree) error(E_NOMEM);  /* create an item set tree */
+  ist_setthr(istree, thcnt);    /* and set the number of threads */
+  if ((target == TT_CONTR)      /* for contrast sets the measure */
+  &&  (ist_init(istree, 1, arem, minval) < 0))  /* is needed for */
+    error(E_NOMEM);             /* pruning the candidates */
+  if (topk > 0) {               /* if to find only the k best */
+    best = (SUPP*)malloc(topk *sizeof(SUPP));
+    if (!best) error(E_NOMEM);  /* create a heap for the supports */
+  }                             /* of the best sets/rules */
+
+  /* --- find frequent item sets with FP-growth or eclat --- */
+  if (((algo != 'a') || (par > 0)) && !direct) {
+    MSG(fprintf(stderr, "finding frequent item sets with %s%s ... ",
+                (algo == 'e') ? "eclat" : (algo == 'f') ? "FP-growth"
+                : "apriori", (par > 0) ? " (projections)" : ""));
+    repo = sr_create();         /* create an item set repository */
+    if (!repo) error(E_NOMEM);  /* and collect the frequent sets */
+    if (_mine(algo, par, ist_getsupp(istree), 1, maxlen,
+              _store, repo) < 0)   /* (with the minimal support */
+      error(E_NOMEM);           /* of a set in the item set tree) */
+    while (ist_height(istree) < maxlen) {
+      k = ist_addlvl(istree);   /* while max. height is not reached, */
+      if (k <  0) error(E_NOMEM);   /* add a level to the tree */
+      if (k != 0) break;        /* and take the supports of its */
+      ist_fill(istree, _lookup, repo);    /* item sets from the */
+    }                           /* repository instead of counting */
+    MSG(fprintf(stderr, "[%d set(s)] ", sr_cnt(repo)));
+    sr_delete(repo);            /* delete the repository */
+    MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
+  }                             /* (sets are reported while writing) */
 
   /* --- check item subsets --- */
-  if (filter) {                 /* if to filter unused items */
+  if (filter || recode) {       /* if to filter unused items */
     used = (char*)malloc(is_cnt(itemset) *sizeof(char));
     if (!used) error(E_NOMEM);  /* create a flag vector */
   }                             /* for the items */
-  MSG(fprintf(stderr, "checking subsets of size 1"));
-  while (ist_height(istree) < maxlen) {
-    if (filter != 0) {          /* if to filter w.r.t. item usage, */
+  if ((algo == 'a') && (par <= 0)) {
+    MSG(fprintf(stderr, "checking subsets of size 1")); }
+  while ((algo == 'a') && (par <= 0)
+  &&     (ist_height(istree) < maxlen)) {
+    if (topk > 0) {             /* if to find only the k best */
+      if (_topk(best, &hcnt, topk, target,
+                (lvls < minlen) ? minlen : lvls+1) < 0)
+        error(E_NOMEM);         /* add the sets/rules of the new */
+      lvls = ist_height(istree);/* levels to the heap and raise */
+    }                           /* the support before extending */
+    if ((filter != 0) || recode) {  /* if to check item usage, */
       i = ist_check(istree, used);     /* check current item usage */
+      if (i < 0) error(E_NOMEM);
       if (i < maxlen) maxlen = i;      /* update the maximum size */
       if (ist_height(istree) >= i) break;
     }                           /* check the tree height */
+    if (recode && (ist_height(istree) == 2) && (i < n)) {
+      map = (int*)malloc(is_cnt(itemset) *sizeof(int));
+      if (!map) error(E_NOMEM); /* create an item identifier map */
+      k = ist_recode(istree, used, map);
+      if (k < 0) error(E_NOMEM);/* recode the used items */
+      if ((k > 0) && taset) {   /* if transactions were loaded, */
+        tas_recode(taset, map, k);  /* recode them, too */
+        if (tatree) {           /* if a transaction tree exists, */
+          tat_delete(tatree);   /* rebuild it from the transactions */
+          tatree = tat_create(taset, heap);
+          if (!tatree) error(E_NOMEM);
+        }                       /* (unused items have been removed, */
+      }                         /* so that the transactions shrink) */
+      if (k > 0) n = k;         /* note the new number of items */
+      free(map);                /* delete the item identifier map */
+    }
     k = ist_addlvl(istree);     /* while max. height is not reached, */
     if (k <  0) error(E_NOMEM); /* add a level to the item set tree */
     if (k != 0) break;          /* if no level was added, abort */
+    if (fused && (ist_pairs(istree) == 0)) {
+      MSG(fprintf(stderr, " %d", ist_height(istree)));
+      continue;                 /* if the pairs were counted while */
+    }                           /* reading, skip the counting pass */
+    for (l = 1; (l < lpp) && (ist_height(istree) < maxlen); l++) {
+      k = ist_addopt(istree);   /* add levels optimistically, */
+      if (k <  0) error(E_NOMEM);   /* so that several levels */
+      if (k != 0) break;        /* are counted in one pass */
+    }                           /* through the transactions */
     MSG(fprintf(stderr, " %d", ist_height(istree)));
+    if (taset && (mode & IST_TIDS)
+    &&  ((k = ist_tidcnt(istree, taset)) != 0)) {
+      if (k < 0) error(E_NOMEM);/* if the level was counted with */
+      continue;                 /* candidate id. lists (which are */
+    }                           /* smaller than the transactions) */
     if (tatree) {               /* if a transaction tree was created */
       if (((filter < 0)         /* if to filter w.r.t. item usage */
       &&   (i < -filter *n))    /* and enough items were removed */
@@ -568,8 +1076,7 @@ int main (int argc, char *argv[])
         tas_filter(taset, used);/* and remove unnecessary items */
         tt = clock() -t;        /* from the transactions */
       }                         /* note the filtering time */
-      for (i = tacnt; --i >= 0;)/* traverse and count transactions */
-        ist_count(istree, tas_tract(taset, i), tas_tsize(taset, i));
+      ist_counts(istree, taset);/* count the transactions */
       tc = clock() -t; }        /* note the new count time */
     else {                      /* if to work on the input file, */
       rewind(in);               /* reset the file position */
@@ -589,14 +1096,25 @@ int main (int argc, char *argv[])
     if (in != stdin) fclose(in);/* if not read from standard input, */
     in = NULL;                  /* close the input file */
   }                             /* clear the file variable */
-  MSG(fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t)));
+  if ((algo == 'a') && (par <= 0)) {
+    MSG(fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t))); }
+  if (topk > 0) {               /* if to find only the k best */
+    if (_topk(best, &hcnt, topk, target,
+              (lvls < minlen) ? minlen : lvls+1) < 0)
+      error(E_NOMEM);           /* add the sets/rules of the last */
+    if (hcnt >= topk) {         /* levels and report the support */
+      MSG(fprintf(stderr, "minimal support of the top %d %s(s): "
+                  SUPP_FMT "\n", topk, ttypes[target], best[0])); }
+    free(best); best = NULL;    /* delete the heap of supports */
+  }
 
   /* --- filter found item sets --- */
-  if ((target == TT_CLSET) || (target == TT_MFSET)) {
+  if (((target == TT_CLSET) || (target == TT_MFSET)) && !direct) {
     MSG(fprintf(stderr, "filtering %s item sets ... ",
         (target == TT_MFSET) ? "maximal" : "closed"));
     t = clock();                /* filter the item sets */
-    ist_filter(istree, (target == TT_MFSET) ? IST_MAXFRQ : IST_CLOSED);
+    k = ist_filter(istree, (target == TT_MFSET) ? IST_MAXFRQ:IST_CLOSED);
+    if (k < 0) error(E_NOMEM);  /* filter the item sets */
     MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
   }                             /* (filter takes longer than print) */
 
@@ -620,33 +1138,55 @@ int main (int argc, char *argv[])
     out = stdout; fn_out = "<stdout>"; }    /* write to std. output */
   MSG(fprintf(stderr, "writing %s ... ", fn_out));
   if (!out) error(E_FOPEN, fn_out);
-  ist_init(istree, minlen, arem, minval);
+  if (ist_init(istree, minlen, arem, minval) < 0)
+    error(E_NOMEM);             /* initialize the extraction */
   set = is_tract(itemset);      /* get the transaction buffer */
-  if (target <= TT_MFSET) {     /* if to find frequent item sets */
+  if (direct) {                 /* if to find item sets directly */
+    n = 0;                      /* (closed sets with LCM, */
+    if      (target == TT_CLSET)/* maximal sets with GenMax) */
+      k = lcm_mine(taset, smin, minlen, maxlen, _report, &n);
+    else if (target == TT_MFSET)
+      k = gmx_mine(taset, smin, minlen, _report, &n);
+    else
+      k = _mine(algo, par, smin, minlen, maxlen, _report, &n);
+    if (k < 0) error(E_NOMEM);  /* report the sets directly */
+  }
+  else if (target <= TT_MFSET){ /* if to find frequent item sets */
     for (n = 0; 1; ) {          /* extract item sets from the tree */
       k = ist_set(istree, set, &frq, &conf);
       if (k <= 0) break;        /* get the next frequent item set */
       if (frq > smax) continue; /* check against maximal support */
+      _setout(set, k, frq, conf);
+      n++;                      /* print the item set */
+    } }                         /* and count it */
+  else if (target == TT_CONTR){ /* if to find contrast sets */
+    for (n = 0; 1; ) {          /* extract contrast sets from tree */
+      k = ist_cset(istree, set, gsupp, &minval);
+      if (k <= 0) break;        /* get the next contrast set */
+      grel[0] = gsupp[0] /(double)gsz[0];
+      grel[1] = gsupp[1] /(double)gsz[1];
+      if (!((gsupp[1] >= gmin[1]) && (grel[1] >= grow *grel[0]))
+      &&  !((gsupp[0] >= gmin[0]) && (grel[0] >= grow *grel[1])))
+        continue;               /* check support and growth rate */
       for (i = 0; i < k; i++) { /* traverse the set's items */
         name = is_name(itemset, set[i]);
         if (c2scf) { sc_format(buf, name, 0); name = buf; }
         fputs(name, out);       /* print the name of the next item */
         fputs((i < k-1) ? sep : " ", out);
       }                         /* print a separator */
-      fputs(" (", out);         /* print the item set's support */
-      if (sout & 1) { fprintf(out, fmt, (frq/(double)tacnt) *100);
-                      if (sout & 2) fputc('/', out); }
-      if (sout & 2) { fprintf(out, "%d", frq); }
-      if (ext) {                /* if to print the extended support */
-        frq = tas_occur(taset, set, k);
-        fputs(", ", out);       /* get the number of occurrences */
-        fprintf(out, fmt, (frq/(double)tacnt) *100);
-        if (sout & 2) fprintf(out, "/%d", frq);
-      }                         /* print the extended support data */
-      if (aval) { fputs(", ", out); fprintf(out, fmt, conf *100); }
-      fputs(")\n", out);        /* print the add. eval. measure, */
-      n++;                      /* terminate the support output, */
-    } }                         /* and count the item set */
+      fputs(" (", out);         /* print the supports in the groups */
+      for (i = 0; i < 2; i++) { /* and the growth rate from group 1 */
+        if (sout & 1) { fprintf(out, fmt, grel[i] *100);
+                        if (sout & 2) fputc('/', out); }
+        if (sout & 2) { fprintf(out, SUPP_FMT, gsupp[i]); }
+        fputs(", ", out);       /* to group 2 (infinite if the set */
+      }                         /* does not occur in group 1) */
+      if (grel[0] > 0) fprintf(out, fmt, grel[1] /grel[0]);
+      else             fputs("inf", out);
+      if (aval) { fputs(", ", out); fprintf(out, fmt, minval *100); }
+      fputs(")\n", out);        /* print the add. measure value */
+      n++;                      /* and count the contrast set */
+    } }
   else if (target == TT_RULE) { /* if to find association rules, */
     for (n = 0; 1; ) {          /* extract rules from tree */
       k = ist_rule(istree, set, &frq, &conf, &lftval, &minval);
@@ -663,17 +1203,17 @@ int main (int argc, char *argv[])
       if (ext && !(mode & IST_HEAD)) {
         if (sout & 1) { fprintf(out, fmt, supp *conf *100);
                         if (sout & 2) fputc('/', out); }
-        if (sout & 2) { fprintf(out, "%d", (int)(frq *conf +0.5));}
+        if (sout & 2) { fprintf(out, SUPP_FMT, (SUPP)(frq *conf +0.5));}
         fputs(", ", out);       /* print the support of the rule */
       }                         /* from  the support of the body */
       if (sout & 1) { fprintf(out, fmt, supp *100);
                       if (sout & 2) fputc('/', out); }
-      if (sout & 2) { fprintf(out, "%d", frq); }
+      if (sout & 2) { fprintf(out, SUPP_FMT, frq); }
       fputs(", ", out);         /* print the rule support */
       if (ext && (mode & IST_HEAD)) {
         if (sout & 1) { fprintf(out, fmt, (supp/conf) *100);
                         if (sout & 2) fputc('/', out); }
-        if (sout & 2) { fprintf(out, "%d", (int)(frq /conf +0.5));}
+        if (sout & 2) { fprintf(out, SUPP_FMT, (SUPP)(frq /conf +0.5));}
         fputs(", ", out);       /* print the support of the body */
       }                         /* from  the support of the rule */
       fprintf(out, fmt, conf *100); /* print the rule confidence */
@@ -696,7 +1236,7 @@ int main (int argc, char *argv[])
       fputs(" (", out);         /* print the hyperedge evaluation */
       if (sout & 1) { fprintf(out, fmt, (frq/(double)tacnt) *100);
                       if (sout & 2) fputc('/', out); }
-      if (sout & 2) { fprintf(out, "%d", frq); }
+      if (sout & 2) { fprintf(out, SUPP_FMT, frq); }
       fputs(", ", out); fprintf(out, fmt, conf *100);
       if (aval) { fputs(", ", out); fprintf(out, fmt, minval *100); }
       fputs(")\n", out);        /* print support and confidence */
@@ -716,7 +1256,7 @@ int main (int argc, char *argv[])
       fputs(" (", out);         /* print the group evaluation */
       if (sout & 1) { fprintf(out, fmt, (frq/(double)tacnt) *100);
                       if (sout & 2) fputc('/', out); }
-      if (sout & 2) { fprintf(out, "%d", frq); }
+      if (sout & 2) { fprintf(out, SUPP_FMT, frq); }
       if (aval) { fputs(", ", out); fprintf(out, fmt, minval *100); }
       fputs(")\n", out);        /* print support and add. measure */
       n++;                      /* and count the group */
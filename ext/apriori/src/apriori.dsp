@@ -94,6 +94,34 @@ SOURCE=.\istree.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\hshtree.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\setrepo.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\fpgrowth.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\eclat.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\lcm.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\genmax.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\parmine.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\util\src\scan.c
 # End Source File
 # Begin Source File
@@ -4,11 +4,19 @@
 # Author  : Christian Borgelt
 # History : 26.01.2003 file created
 #           20.07.2006 adapted to Visual Studio 8
+#           19.10.2026 parallel counting disabled (no pthreads)
+#           19.10.2026 counting function template istcnt.h added
+#           19.10.2026 module hshtree (hash tree counting) added
+#           19.10.2026 modules setrepo and fpgrowth added
+#           19.10.2026 module eclat added
+#           19.10.2026 module lcm added
+#           19.10.2026 module genmax added
+#           19.10.2026 module parmine added
 #-----------------------------------------------------------------------
 CC      = cl.exe
 LD      = link.exe
 DEFS    = /D WIN32 /D NDEBUG /D _CONSOLE /D _MBCS \
-          /D _CRT_SECURE_NO_DEPRECATE
+          /D _CRT_SECURE_NO_DEPRECATE /D NOTHREADS
 CFLAGS  = /nologo /W3 /EHsc /O2 /I $(UTILDIR) /I $(MATHDIR) $(DEFS) /FD /c
 LDFLAGS = /nologo /subsystem:console /incremental:no /machine:X86
 
@@ -18,11 +26,13 @@ MATHDIR = ..\..\math\src
 HDRS    = $(UTILDIR)\vecops.h    $(UTILDIR)\symtab.h \
           $(UTILDIR)\tabscan.h   $(UTILDIR)\scan.h \
           $(MATHDIR)\gamma.h     $(MATHDIR)\chi2.o \
-          tract.h istree.h
+          tract.h hshtree.h istree.h istcnt.h setrepo.h fpgrowth.h \
+          eclat.h lcm.h genmax.h parmine.h
 OBJS    = $(UTILDIR)\vecops.obj  $(UTILDIR)\nimap.obj \
           $(UTILDIR)\tabscan.obj $(UTILDIR)\scan.obj \
           $(MATHDIR)\gamma.obj   $(MATHDIR)\chi2.obj \
-          tract.obj istree.obj apriori.obj
+          tract.obj hshtree.obj istree.obj setrepo.obj fpgrowth.obj \
+          eclat.obj lcm.obj genmax.obj parmine.obj apriori.obj
 
 #-----------------------------------------------------------------------
 # Build Program
@@ -38,16 +48,61 @@ apriori.exe: $(OBJS)
 tract.obj:   $(UTILDIR)\symtab.h tract.h tract.c apriori.mak
 	$(CC) $(CFLAGS) tract.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Hash Tree Management
+#-----------------------------------------------------------------------
+hshtree.obj: hshtree.h hshtree.c apriori.mak
+	$(CC) $(CFLAGS) hshtree.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Frequent Item Set Tree Management
 #-----------------------------------------------------------------------
-istree.obj:  $(MATHDIR)\gamma.h tract.h istree.h istree.c apriori.mak
+istree.obj:  $(MATHDIR)\gamma.h tract.h hshtree.h istree.h istcnt.h \
+             istree.c apriori.mak
 	$(CC) $(CFLAGS) istree.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Item Set Repository Management
+#-----------------------------------------------------------------------
+setrepo.obj: tract.h setrepo.h setrepo.c apriori.mak
+	$(CC) $(CFLAGS) setrepo.c /Fo$@
+
+#-----------------------------------------------------------------------
+# FP-growth Algorithm
+#-----------------------------------------------------------------------
+fpgrowth.obj: tract.h fpgrowth.h fpgrowth.c apriori.mak
+	$(CC) $(CFLAGS) fpgrowth.c /Fo$@
+
+#-----------------------------------------------------------------------
+# Eclat Algorithm
+#-----------------------------------------------------------------------
+eclat.obj:   tract.h eclat.h eclat.c apriori.mak
+	$(CC) $(CFLAGS) eclat.c /Fo$@
+
+#-----------------------------------------------------------------------
+# LCM Algorithm (Closed Item Sets)
+#-----------------------------------------------------------------------
+lcm.obj:     tract.h lcm.h lcm.c apriori.mak
+	$(CC) $(CFLAGS) lcm.c /Fo$@
+
+#-----------------------------------------------------------------------
+# GenMax Algorithm (Maximal Item Sets)
+#-----------------------------------------------------------------------
+genmax.obj:  tract.h setrepo.h genmax.h genmax.c apriori.mak
+	$(CC) $(CFLAGS) genmax.c /Fo$@
+
+#-----------------------------------------------------------------------
+# Parallel Mining of Projections
+#-----------------------------------------------------------------------
+parmine.obj: tract.h parmine.h parmine.c apriori.mak
+	$(CC) $(CFLAGS) parmine.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Main Program
 #-----------------------------------------------------------------------
-apriori.obj: $(UTILDIR)\symtab.h tract.h istree.h apriori.c apriori.mak
+apriori.obj: $(UTILDIR)\symtab.h tract.h hshtree.h istree.h \
+             setrepo.h fpgrowth.h eclat.h lcm.h \
+             genmax.h parmine.h apriori.c apriori.mak
 	$(CC) $(CFLAGS) /D NIMAPFN apriori.c /Fo$@
 
 #-----------------------------------------------------------------------
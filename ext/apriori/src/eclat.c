@@ -0,0 +1,270 @@
+/*----------------------------------------------------------------------
+  File    : eclat.c
+  Contents: eclat algorithm for finding frequent item sets
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 item appearances respected (head only items)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <assert.h>
+#include "eclat.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  The eclat algorithm (Zaki et al. 1997) represents the transactions
+vertically: for each item it stores the list of the identifiers of the
+transactions that contain it (tid-list). The search is a depth-first
+traversal of the item subset lattice: all item sets that share a prefix
+(an equivalence class) are processed together, and the tid-lists of
+the extensions of a set are obtained by intersecting its tid-list with
+those of the other sets of its class. Hence only the tid-lists on the
+current path of the recursion are kept, so the memory needed grows
+with the depth of the recursion and not with the size of a level.
+  Instead of intersecting the tid-list of a set with the tid-lists of
+all other sets of its class one by one, the transactions listed in its
+tid-list are traversed and their identifiers are delivered to all
+extensions they contain (occurrence deliver, as in LCM), which yields
+all intersections in one pass, whose costs are proportional to the
+size of the conditional database. In a first pass the supports of the
+extensions are counted, so that lists are created only for frequent
+extensions and the exact size of the memory needed is known.
+  For dense data the tid-lists are long. Therefore the search switches
+to diffsets (Zaki and Gouda 2003) if the diffsets of a class are
+smaller than its tid-lists: instead of the identifiers of the trans-
+actions that contain an extension, those of the transactions that
+contain the set, but not the extension are stored. The support of the
+extension is then the support of the set minus the size of its
+diffset. Diffsets are combined by a merge (the diffset of the set is
+removed from the diffset of the other set). Once diffsets are used,
+they are kept for the rest of the subtree, because the diffsets of
+deeper levels can only shrink.
+  The items are processed in ascending order w.r.t. their frequency,
+so that the (expensive) classes of frequent items get fewer members.
+  Items to ignore get no tid-list and, as in the item set tree, a set
+may contain at most one head only item: the class of a head only item
+does not contain any other head only items.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- eclat search data --- */
+  SUPP    supp;                 /* minimal support of an item set */
+  int     min, max;             /* minimal and maximal set size */
+  ISREPFN *report;              /* item set report function */
+  void    *data;                /* data for the report function */
+  int     *codes;               /* map from ranks to item codes */
+  int     *set;                 /* current item set (as ranks) */
+  int     *out;                 /* buffer for reported item sets */
+  int     **tras;               /* transactions (ranks, descending) */
+  int     *map;                 /* map from ranks to class indices */
+  int     *cnts;                /* support counters of a class */
+  char    *hdonly;              /* flags for head only items (ranks) */
+} ECLAT;                        /* (eclat search data) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int _diff (int *dst, const int *a, int na,
+                  const int *b, int nb, int max)
+{                               /* --- compute difference of lists */
+  int *d = dst;                 /* to traverse the destination */
+  const int *ea = a +na, *eb = b +nb;   /* ends of the lists */
+
+  assert(dst && a && b);        /* check the function arguments */
+  while (a < ea) {              /* traverse the first list */
+    if      ((b >= eb) || (*a < *b)) {
+      if ((int)(d -dst) >= max) return max+1;
+      *d++ = *a++; }            /* copy identifiers not in 2nd list */
+    else if (*a > *b) b++;      /* (abort if the diffset gets too */
+    else            { a++; b++; }     /* long for a frequent set) */
+  }
+  return (int)(d -dst);         /* return the size of the diffset */
+}  /* _diff() */
+
+/*--------------------------------------------------------------------*/
+
+static int _report (ECLAT *ecl, int cnt, SUPP supp)
+{                               /* --- report an item set */
+  int i;                        /* loop variable */
+
+  assert(ecl && (cnt > 0));     /* check the function arguments */
+  for (i = cnt; --i >= 0; )     /* map the ranks to item codes */
+    ecl->out[i] = ecl->codes[ecl->set[i]];
+  ta_sort(ecl->out, cnt);       /* sort the items of the set */
+  return ecl->report(ecl->out, cnt, supp, ecl->data);
+}  /* _report() */
+
+/*--------------------------------------------------------------------*/
+
+static int _search (ECLAT *ecl, TIDLIST *lists, int n, int diff,
+                    int depth)
+{                               /* --- recursive part of eclat */
+  int     i, j, k, m, r;        /* loop variables, buffers */
+  int     *t, *p;               /* to traverse the items/identifiers */
+  int     *map  = ecl->map;     /* map from ranks to class indices */
+  int     *cnts = ecl->cnts;    /* support counters of the class */
+  int     dense;                /* whether to use diffsets */
+  size_t  total, size;          /* total size of the new lists */
+  TIDLIST *l, *d, *proj;        /* current, new and projected lists */
+  char    *skip;                /* flags of items not to combine */
+
+  assert(ecl && lists && (n > 0));  /* check the function arguments */
+  for (i = 0; i < n; i++) {     /* traverse the sets of the class */
+    l = lists +i;               /* note the item of the current set */
+    ecl->set[depth] = l->item;  /* and report the set if it is large */
+    if ((depth >= ecl->min -1)  /* enough (the support was already */
+    &&  (_report(ecl, depth+1, l->supp) < 0))   /* checked) */
+      return -1;
+    if ((i >= n-1) || (depth+1 >= ecl->max))
+      continue;                 /* check whether to extend the set */
+    skip = (ecl->hdonly[l->item]) ? ecl->hdonly : NULL;
+    if (diff) {                 /* if diffsets are used, */
+      dense = 1;                /* keep using them */
+      for (total = 0, j = i+1; j < n; j++)
+        if (!skip || !skip[lists[j].item])
+          total += (size_t)lists[j].cnt; }
+    else {                      /* if tid-lists are used */
+      for (j = i+1; j < n; j++) {  /* (skipped items stay infrequent) */
+        map[lists[j].item] = (skip && skip[lists[j].item]) ? -1 : j;
+        cnts[j] = 0;            /* note the class indices */
+      }                         /* and clear the counters */
+      for (k = l->cnt; --k >= 0; )  /* count the extensions */
+        for (t = ecl->tras[l->tids[k]]; *t > l->item; t++)
+          if (map[*t] >= 0) cnts[map[*t]]++;
+      for (total = size = 0, j = i+1; j < n; j++) {
+        map[lists[j].item] = -1;/* clear the class indices */
+        if (cnts[j] < ecl->supp) continue;
+        total += (size_t)cnts[j];        /* sum the sizes of the */
+        size  += (size_t)(l->cnt -cnts[j]);  /* tid-lists and the */
+      }                         /* diffsets of the frequent sets */
+      dense = (size < total);   /* use diffsets if they are smaller */
+      if (dense) total = size;  /* than the tid-lists */
+    }
+    proj = (TIDLIST*)malloc((n-i-1) *sizeof(TIDLIST)
+                           +total   *sizeof(int));
+    if (!proj) return -1;       /* create the lists of the class */
+    p = (int*)(proj +(n-i-1));  /* (identifiers follow the lists) */
+    for (m = 0, j = i+1; j < n; j++) {
+      if ((skip && skip[lists[j].item])
+      ||  (!diff && (cnts[j] < ecl->supp)))
+        continue;               /* skip a second head only item */
+                                /* and infrequent extensions */
+      d = proj +m;              /* traverse the other sets of the */
+      d->item = lists[j].item;  /* class and compute the tid-list */
+      d->tids = p;              /* or diffset of the combined set */
+      if      (diff)            /* d(Pij) = d(Pj) - d(Pi) */
+        k = _diff(p, lists[j].tids, lists[j].cnt, l->tids, l->cnt,
+                  (int)(l->supp -ecl->supp));
+      else if (dense)           /* d(Pij) = t(Pi) - t(Pj) */
+        k = _diff(p, l->tids, l->cnt, lists[j].tids, lists[j].cnt,
+                  l->cnt);      /* (tid-lists are filled below) */
+      else { map[d->item] = m; k = 0; }
+      d->supp = (diff || dense) ? l->supp -k : (SUPP)cnts[j];
+      if (d->supp < ecl->supp)  /* compute the support and */
+        continue;               /* skip infrequent extensions */
+      d->cnt = k; m++;          /* store the list of the extension */
+      p += (diff || dense) ? k : cnts[j];
+    }
+    if (!diff && !dense) {      /* if to create tid-lists, */
+      for (k = 0; k < l->cnt; k++)  /* deliver the identifiers */
+        for (t = ecl->tras[l->tids[k]]; *t > l->item; t++)
+          if (map[*t] >= 0) {   /* traverse the transactions */
+            d = proj +map[*t];  /* and add their identifiers */
+            d->tids[d->cnt++] = l->tids[k];
+          }                     /* to the lists of the extensions */
+      for (j = 0; j < m; j++) map[proj[j].item] = -1;
+    }                           /* clear the class indices */
+    r = (m > 0) ? _search(ecl, proj, m, dense, depth+1) : 0;
+    free(proj);                 /* process the class recursively */
+    if (r < 0) return -1;       /* and delete its lists afterwards */
+  }
+  return 0;                     /* return 'ok' */
+}  /* _search() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int ecl_mine (TASET *taset, SUPP supp, int min, int max,
+              ISREPFN *report, void *data)
+{                               /* --- find frequent item sets */
+  int     i, k, n, m;           /* loop variables, numbers of items */
+  int     *ranks, *p, *s;       /* item ranks, to traverse the items */
+  SUPP    *frqs;                /* item frequencies */
+  size_t  total;                /* total size of the tid-lists */
+  TIDLIST *lists, *l;           /* tid-lists of the frequent items */
+  ITEMSET *iset;                /* item set of the transactions */
+  ECLAT   ecl;                  /* search data */
+
+  assert(taset && report && (min > 0) && (max >= min));
+  iset = tas_itemset(taset);    /* get the item set and */
+  n    = is_cnt(iset);          /* the number of items */
+  if (n <= 0) return 0;
+  frqs = (SUPP*)calloc(n, sizeof(SUPP) +6*sizeof(int) +sizeof(char));
+  if (!frqs) return -1;         /* create the item vectors */
+  ranks      = (int*)(frqs +n); /* (frequencies, ranks, codes, */
+  ecl.codes  = ranks +n;        /* current item set, output buffer, */
+  ecl.set    = ecl.codes +n;    /* class indices, counters, */
+  ecl.out    = ecl.set   +n;    /* head only flags) */
+  ecl.map    = ecl.out   +n;
+  ecl.cnts   = ecl.map   +n;
+  ecl.hdonly = (char*)(ecl.cnts +n);
+  for (i = tas_cnt(taset); --i >= 0; )
+    for (s = tas_tract(taset, i), k = tas_tsize(taset, i); --k >= 0; )
+      frqs[s[k]]++;             /* determine the item frequencies */
+  ecl.supp = (supp > 0) ? supp : 1;
+  for (total = 0, m = i = 0; i < n; i++)
+    if ((frqs[i] >= ecl.supp)   /* collect the frequent items */
+    &&  (is_getapp(iset, i) != APP_NONE)) {  /* (except items */
+      ecl.codes[m++] = i; total += (size_t)frqs[i]; }  /* to ignore) */
+  for (i = 1; i < m; i++) {     /* sort the frequent items */
+    k = ecl.codes[i];           /* ascendingly w.r.t. frequency */
+    for (p = ecl.codes +i; (--p >= ecl.codes) && (frqs[*p] > frqs[k]); )
+      p[1] = *p;                /* (insertion sort keeps the order */
+    p[1] = k;                   /* of items with equal frequency) */
+  }
+  if (m <= 0) { free(frqs); return 0; }
+  for (i = 0; i < n; i++) ranks[i] = ecl.map[i] = -1;
+  for (i = 0; i < m; i++) {     /* set the ranks and note */
+    ranks[ecl.codes[i]] = i;    /* which items are head only */
+    ecl.hdonly[i] = (char)(is_getapp(iset, ecl.codes[i]) == APP_HEAD);
+  }
+  lists = (TIDLIST*)malloc(m *sizeof(TIDLIST) +total *sizeof(int));
+  ecl.tras = (int**)malloc(tas_cnt(taset) *sizeof(int*)
+                          +(total +tas_cnt(taset)) *sizeof(int));
+  if (!lists || !ecl.tras) {    /* create the tid-lists */
+    free(ecl.tras); free(lists); free(frqs); return -1; }
+  p = (int*)(lists +m);         /* initialize the tid-lists */
+  for (i = 0; i < m; i++) {     /* (the identifier vectors follow */
+    lists[i].item = i;          /* the list headers) */
+    lists[i].supp = frqs[ecl.codes[i]];
+    lists[i].cnt  = 0;
+    lists[i].tids = p; p += lists[i].supp;
+  }
+  p = (int*)(ecl.tras +tas_cnt(taset));
+  for (i = 0; i < tas_cnt(taset); i++) {
+    s = tas_tract(taset, i);    /* traverse the transactions */
+    for (ecl.tras[i] = p, k = tas_tsize(taset, i); --k >= 0; )
+      if (ranks[s[k]] >= 0) {   /* and add their identifiers */
+        l = lists +ranks[s[k]]; /* to the tid-lists of the */
+        l->tids[l->cnt++] = i;  /* contained items (the identifiers */
+        *p++ = ranks[s[k]];     /* are added in ascending order) */
+      }                         /* and replace the items by ranks */
+    k = (int)(p -ecl.tras[i]);  /* sort the ranks descendingly */
+    ta_sort(ecl.tras[i], k); v_intrev(ecl.tras[i], k);
+    *p++ = -1;                  /* store a sentinel */
+  }
+  ecl.min    = min;             /* note the search parameters */
+  ecl.max    = max;
+  ecl.report = report;
+  ecl.data   = data;
+  k = _search(&ecl, lists, m, 0, 0);
+  free(ecl.tras);               /* find frequent item sets recursively */
+  free(lists);                  /* and delete the tid-lists, */
+  free(frqs);                   /* the transactions and the vectors */
+  return k;                     /* return the error status */
+}  /* ecl_mine() */
@@ -0,0 +1,27 @@
+/*----------------------------------------------------------------------
+  File    : eclat.h
+  Contents: eclat algorithm for finding frequent item sets
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __ECLAT__
+#define __ECLAT__
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- transaction identifier list --- */
+  int     item;                 /* associated item (frequency rank) */
+  SUPP    supp;                 /* support of the extended item set */
+  int     cnt;                  /* number of transaction identifiers */
+  int     *tids;                /* transaction identifiers (ascending; */
+} TIDLIST;                      /* tid-list or diffset of the item) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int ecl_mine (TASET *taset, SUPP supp, int min, int max,
+                     ISREPFN *report, void *data);
+
+#endif
@@ -0,0 +1,316 @@
+/*----------------------------------------------------------------------
+  File    : fpgrowth.c
+  Contents: FP-growth algorithm for finding frequent item sets
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 item appearances respected (head only items)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "fpgrowth.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  The FP-growth algorithm (Han, Pei and Yin 2000) represents the trans-
+actions as a prefix tree (frequent pattern tree), in which the items
+of each transaction are sorted descendingly w.r.t. their frequency, so
+that the paths share as many nodes as possible. All nodes of the same
+item are linked into a list that starts in the header of the tree, so
+that the paths that contain an item can be found quickly.
+  The frequent item sets are found by processing the items from the
+least frequent to the most frequent one. For each item the prefixes
+of its paths, weighted with the support of the item's nodes, form the
+conditional pattern base of the item. Its frequent items are collected
+(locally recoded, so that the header stays small) into a new tree, in
+which the search proceeds recursively with the item added to the set.
+  The initial tree is built from the transactions by sorting them
+lexicographically, so that all transactions that share a prefix are
+adjacent. Each transaction then only has to be compared to the one
+before it and the nodes of the common prefix are reused, which makes
+a search for child nodes unnecessary. A conditional tree is built by
+copying the ancestors of the item's nodes that carry frequent items:
+each copied node notes its copy, so that the copy of a shared prefix
+is created only once and the structure of the tree is kept. (Paths
+that differ only in infrequent items are not merged, but this affects
+only the compression, not the supports.)
+  Items to ignore are excluded from the search and, as in the item set
+tree, a set may contain at most one head only item: the conditional
+tree of a head only item does not contain any head only items.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- a (weighted) transaction --- */
+  SUPP    wgt;                  /* weight (number of transactions) */
+  int     cnt;                  /* number of items */
+  int     *items;               /* items in ascending code order */
+} FPTRACT;                      /* (weighted transaction) */
+
+typedef struct {                /* --- FP-growth search data --- */
+  SUPP    supp;                 /* minimal support of an item set */
+  int     min, max;             /* minimal and maximal set size */
+  ISREPFN *report;              /* item set report function */
+  void    *data;                /* data for the report function */
+  int     *codes;               /* map from ranks to item codes */
+  int     *set;                 /* current item set (as ranks) */
+  int     *out;                 /* buffer for reported item sets */
+  char    *hdonly;              /* flags for head only items (ranks) */
+} FPGROWTH;                     /* (FP-growth search data) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int _tacmp (const void *p1, const void *p2)
+{                               /* --- compare two transactions */
+  const FPTRACT *a = (const FPTRACT*)p1;
+  const FPTRACT *b = (const FPTRACT*)p2;
+  int i, n;                     /* loop variable, common length */
+
+  n = (a->cnt < b->cnt) ? a->cnt : b->cnt;
+  for (i = 0; i < n; i++) {     /* compare the items lexicographically */
+    if (a->items[i] < b->items[i]) return -1;
+    if (a->items[i] > b->items[i]) return +1;
+  }                             /* if one transaction is a prefix */
+  return a->cnt -b->cnt;        /* of the other, the shorter one */
+}  /* _tacmp() */                /* precedes the longer one */
+
+/*--------------------------------------------------------------------*/
+
+static void _clear (FPTREE *tree)
+{                               /* --- delete the vectors of a tree */
+  assert(tree);                 /* check the function argument */
+  free(tree->nodes); free(tree->lists);
+  free(tree->supps); free(tree->ids);
+}  /* _clear() */
+
+/*--------------------------------------------------------------------*/
+
+static int _build (FPTREE *tree, int cnt, FPTRACT *tas, int n, int total)
+{                               /* --- build a frequent pattern tree */
+  int     i, k, l;              /* loop variables, length of prefix */
+  FPTRACT *t, *p;               /* current and previous transaction */
+  FPNODE  *node;                /* to traverse the new nodes */
+  FPNODE  **path;               /* current path in the tree */
+
+  assert(tree && (cnt > 0) && tas && (n > 0) && (total > 0));
+  tree->cnt   = cnt;            /* note the number of items */
+  tree->supps = (SUPP*)  calloc(cnt, sizeof(SUPP));
+  tree->lists = (FPNODE**)calloc(cnt +cnt, sizeof(FPNODE*));
+  tree->nodes = (FPNODE*) malloc(total *sizeof(FPNODE));
+  if (!tree->supps || !tree->lists || !tree->nodes)
+    return -1;                  /* allocate the tree vectors */
+  path = tree->lists +cnt;      /* (the path buffer follows the lists) */
+  qsort(tas, n, sizeof(FPTRACT), _tacmp);
+  node = tree->nodes;           /* sort the transactions and */
+  for (p = NULL, t = tas; t < tas +n; p = t++) {
+    l = 0;                      /* traverse the sorted transactions */
+    if (p) {                    /* find the common prefix length */
+      k = (p->cnt < t->cnt) ? p->cnt : t->cnt;
+      while ((l < k) && (p->items[l] == t->items[l])) l++;
+    }
+    for (i = 0; i < l; i++)     /* add the weight of the transaction */
+      path[i]->supp += t->wgt;  /* to the nodes of the common prefix */
+    for ( ; i < t->cnt; i++) {  /* create nodes for the rest */
+      node->item   = k = t->items[i];
+      node->supp   = t->wgt;    /* set the item and the support */
+      node->parent = (i > 0) ? path[i-1] : NULL;
+      node->copy   = NULL;      /* link the node to its parent */
+      node->succ   = tree->lists[k];
+      tree->lists[k] = node;    /* add the node to the item's list */
+      path[i] = node++;         /* and note it in the current path */
+    }
+    for (i = t->cnt; --i >= 0; )/* sum the item supports */
+      tree->supps[t->items[i]] += t->wgt;
+  }
+  return 0;                     /* return 'ok' */
+}  /* _build() */
+
+/*--------------------------------------------------------------------*/
+
+static int _project (FPTREE *dst, FPTREE *src, int item, SUPP supp,
+                     const char *skip)
+{                               /* --- build a conditional tree */
+  int    i, m;                  /* loop variable, number of items */
+  int    total;                 /* total number of nodes */
+  int    *map;                  /* map from old to new codes */
+  SUPP   *cnts;                 /* item supports in the condition */
+  FPNODE *node, *anc;           /* to traverse the nodes */
+  FPNODE *cpy, *last;           /* first and last new copy */
+  FPNODE *end;                  /* end of the new nodes */
+
+  assert(dst && src && (item > 0) && (item < src->cnt));
+  cnts = (SUPP*)calloc(item, sizeof(SUPP) +sizeof(int));
+  if (!cnts) return -1;         /* create counters and an item map */
+  map  = (int*)(cnts +item);    /* (only preceding items can occur) */
+  for (total = 0, node = src->lists[item]; node; node = node->succ)
+    for (anc = node->parent; anc; anc = anc->parent) {
+      cnts[anc->item] += node->supp; total++; }
+  for (m = i = 0; i < item; i++)/* count the items in the prefixes */
+    map[i] = ((cnts[i] >= supp)    /* of the item's paths and recode */
+           && (!skip || !skip[src->ids[i]])) ? m++ : -1;
+  if (m <= 0) { free(cnts); return 0; }     /* the frequent ones */
+  dst->cnt   = m;               /* allocate the tree vectors */
+  dst->ids   = (int*)   malloc(m *sizeof(int));
+  dst->supps = (SUPP*)  calloc(m, sizeof(SUPP));
+  dst->lists = (FPNODE**)calloc(m, sizeof(FPNODE*));
+  dst->nodes = (FPNODE*) malloc(total *sizeof(FPNODE));
+  if (!dst->ids || !dst->supps || !dst->lists || !dst->nodes) {
+    _clear(dst); free(cnts); return -1; }
+  for (i = 0; i < item; i++)    /* map the local codes to ranks */
+    if (map[i] >= 0) dst->ids[map[i]] = src->ids[i];
+  end = dst->nodes;             /* traverse the nodes of the item */
+  for (node = src->lists[item]; node; node = node->succ) {
+    for (cpy = last = NULL, anc = node->parent; anc; anc = anc->parent) {
+      if (map[anc->item] < 0) continue;
+      if (anc->copy) break;     /* skip infrequent items and stop */
+      anc->copy = end;          /* at an ancestor that has a copy */
+      end->item   = map[anc->item];
+      end->supp   = 0;          /* create a copy of the ancestor */
+      end->parent = end->copy = NULL;
+      end->succ   = dst->lists[end->item];
+      dst->lists[end->item] = end;
+      if (last) last->parent = end;
+      else      cpy = end;      /* link the copy to the previous one */
+      last = end++;             /* and note the first copy */
+    }                           /* (the copies above it exist) */
+    if (anc) {                  /* if an existing copy was reached, */
+      if (last) last->parent = anc->copy;    /* link the new copies */
+      else      cpy = anc->copy;/* to it or start with it */
+    }
+    for ( ; cpy; cpy = cpy->parent) {
+      cpy->supp += node->supp;  /* add the support of the node */
+      dst->supps[cpy->item] += node->supp;
+    }                           /* to all copies on its path */
+  }
+  for (node = src->lists[item]; node; node = node->succ) {
+    for (anc = node->parent; anc; anc = anc->parent) {
+      if (map[anc->item] < 0) continue;
+      if (!anc->copy) break;    /* clear the copy pointers */
+      anc->copy = NULL;         /* (stop at an ancestor that has */
+    }                           /* already been cleared, since the */
+  }                             /* pointers above it are cleared) */
+  free(cnts);                   /* delete the counters */
+  return m;                     /* return the number of items */
+}  /* _project() */
+
+/*--------------------------------------------------------------------*/
+
+static int _report (FPGROWTH *fpg, int cnt, SUPP supp)
+{                               /* --- report an item set */
+  int i;                        /* loop variable */
+
+  assert(fpg && (cnt > 0));     /* check the function arguments */
+  for (i = cnt; --i >= 0; )     /* map the ranks to item codes */
+    fpg->out[i] = fpg->codes[fpg->set[i]];
+  ta_sort(fpg->out, cnt);       /* sort the items of the set */
+  return fpg->report(fpg->out, cnt, supp, fpg->data);
+}  /* _report() */
+
+/*--------------------------------------------------------------------*/
+
+static int _grow (FPGROWTH *fpg, FPTREE *tree, int depth)
+{                               /* --- recursive part of FP-growth */
+  int    i, r;                  /* loop variable, result buffer */
+  FPTREE proj;                  /* conditional tree */
+
+  assert(fpg && tree);          /* check the function arguments */
+  for (i = tree->cnt; --i >= 0; ) {
+    if (tree->supps[i] < fpg->supp)
+      continue;                 /* skip infrequent items */
+    fpg->set[depth] = tree->ids[i];
+    if ((depth >= fpg->min -1)  /* if the set is large enough, */
+    &&  (_report(fpg, depth+1, tree->supps[i]) < 0))
+      return -1;                /* report the current item set */
+    if ((i <= 0) || (depth+1 >= fpg->max))
+      continue;                 /* check whether to extend the set */
+    r = _project(&proj, tree, i, fpg->supp,
+                 (fpg->hdonly[tree->ids[i]]) ? fpg->hdonly : NULL);
+    if (r <  0) return -1;      /* build the conditional tree */
+    if (r == 0) continue;       /* of the item (without head only */
+                                /* items if the item is head only) */
+    r = _grow(fpg, &proj, depth+1);
+    _clear(&proj);              /* find the frequent item sets */
+    if (r < 0) return -1;       /* in the conditional tree */
+  }                             /* and delete the tree afterwards */
+  return 0;                     /* return 'ok' */
+}  /* _grow() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int fpg_mine (TASET *taset, SUPP supp, int min, int max,
+              ISREPFN *report, void *data)
+{                               /* --- find frequent item sets */
+  int      i, k, n, m;          /* loop variables, numbers of items */
+  int      *ranks, *p, *s;      /* item ranks, to store the items */
+  SUPP     *frqs;               /* item frequencies */
+  FPTRACT  *tas, *t;            /* transactions to build the tree */
+  FPTREE   tree;                /* frequent pattern tree */
+  ITEMSET  *iset;               /* item set of the transactions */
+  FPGROWTH fpg;                 /* search data */
+
+  assert(taset && report && (min > 0) && (max >= min));
+  iset = tas_itemset(taset);    /* get the item set and */
+  n    = is_cnt(iset);          /* the number of items */
+  if (n <= 0) return 0;
+  frqs = (SUPP*)calloc(n, sizeof(SUPP) +4*sizeof(int) +sizeof(char));
+  if (!frqs) return -1;         /* create the item vectors */
+  ranks      = (int*)(frqs +n); /* (frequencies, ranks, codes, */
+  fpg.codes  = ranks +n;        /* current item set, output buffer, */
+  fpg.set    = fpg.codes +n;    /* head only flags) */
+  fpg.out    = fpg.set   +n;
+  fpg.hdonly = (char*)(fpg.out +n);
+  for (i = tas_cnt(taset); --i >= 0; )
+    for (s = tas_tract(taset, i), k = tas_tsize(taset, i); --k >= 0; )
+      frqs[s[k]]++;             /* determine the item frequencies */
+  for (m = i = 0; i < n; i++)   /* collect the frequent items */
+    if ((frqs[i] >= supp) && (is_getapp(iset, i) != APP_NONE))
+      fpg.codes[m++] = i;       /* (except items to ignore) */
+  for (i = 1; i < m; i++) {     /* sort the frequent items */
+    k = fpg.codes[i];           /* descendingly w.r.t. frequency */
+    for (p = fpg.codes +i; (--p >= fpg.codes) && (frqs[*p] < frqs[k]); )
+      p[1] = *p;                /* (insertion sort keeps the order */
+    p[1] = k;                   /* of items with equal frequency) */
+  }
+  for (i = 0; i < n; i++) ranks[i] = -1;
+  for (i = 0; i < m; i++) {     /* set the ranks and note */
+    ranks[fpg.codes[i]] = i;    /* which items are head only */
+    fpg.hdonly[i] = (char)(is_getapp(iset, fpg.codes[i]) == APP_HEAD);
+  }
+  if (m <= 0) { free(frqs); return 0; }
+  tas = (FPTRACT*)malloc(tas_cnt(taset) *sizeof(FPTRACT)
+                        +tas_total(taset) *sizeof(int));
+  if (!tas) { free(frqs); return -1; }
+  p = (int*)(tas +tas_cnt(taset));
+  for (t = tas, n = 0, i = tas_cnt(taset); --i >= 0; ) {
+    s = tas_tract(taset, i);    /* traverse the transactions */
+    for (t->items = p, k = tas_tsize(taset, i); --k >= 0; )
+      if (ranks[s[k]] >= 0) *p++ = ranks[s[k]];
+    t->cnt = (int)(p -t->items);/* replace the items by their ranks */
+    if (t->cnt <= 0) continue;  /* and skip empty transactions */
+    ta_sort(t->items, t->cnt);  /* sort the ranks of the items */
+    t->wgt = 1; n += (t++)->cnt;/* (the most frequent item first) */
+  }
+  tree.ids = (int*)malloc(m *sizeof(int));
+  tree.supps = NULL; tree.lists = NULL; tree.nodes = NULL;
+  k = ((t > tas) && tree.ids)   /* build the frequent pattern tree */
+    ? _build(&tree, m, tas, (int)(t -tas), n) : (tree.ids) ? 1 : -1;
+  free(tas);                    /* delete the transactions */
+  if (k != 0) { _clear(&tree); free(frqs); return (k > 0) ? 0 : -1; }
+  for (i = 0; i < m; i++) tree.ids[i] = i;
+  fpg.supp   = (supp > 0) ? supp : 1;
+  fpg.min    = min;             /* note the search parameters */
+  fpg.max    = max;
+  fpg.report = report;
+  fpg.data   = data;
+  k = _grow(&fpg, &tree, 0);    /* find frequent item sets recursively */
+  _clear(&tree);                /* delete the frequent pattern tree */
+  free(frqs);                   /* and the item vectors */
+  return k;                     /* return the error status */
+}  /* fpg_mine() */
@@ -0,0 +1,36 @@
+/*----------------------------------------------------------------------
+  File    : fpgrowth.h
+  Contents: FP-growth algorithm for finding frequent item sets
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __FPGROWTH__
+#define __FPGROWTH__
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct _fpnode {        /* --- frequent pattern tree node --- */
+  int            item;          /* associated item (local code) */
+  SUPP           supp;          /* support (weight of transactions) */
+  struct _fpnode *parent;       /* parent node (preceding item) */
+  struct _fpnode *succ;         /* successor node with same item */
+  struct _fpnode *copy;         /* copy in a conditional tree */
+} FPNODE;                       /* (frequent pattern tree node) */
+
+typedef struct {                /* --- frequent pattern tree --- */
+  int     cnt;                  /* number of items */
+  int     *ids;                 /* map from local codes to ranks */
+  SUPP    *supps;               /* support of each item */
+  FPNODE  **lists;              /* header links (node list per item) */
+  FPNODE  *nodes;               /* node arena of the tree */
+} FPTREE;                       /* (frequent pattern tree) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int fpg_mine (TASET *taset, SUPP supp, int min, int max,
+                     ISREPFN *report, void *data);
+
+#endif
@@ -0,0 +1,315 @@
+/*----------------------------------------------------------------------
+  File    : genmax.c
+  Contents: GenMax algorithm for finding maximal item sets
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 item appearances respected (head only items)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <assert.h>
+#include "genmax.h"
+#include "setrepo.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  The GenMax algorithm (Gouda and Zaki 2001) searches the maximal item
+sets depth-first. Each node of the search consists of a head (the
+current item set) and a tail (the items that may still be added). The
+following pruning techniques keep the search from enumerating all
+frequent item sets:
+- parent equivalence pruning: a tail item that occurs in all trans-
+  actions that contain the head is added to the head directly,
+  because every maximal set containing the head also contains it;
+- superset look-ahead: if the union of head and tail is a subset of
+  an already found maximal set, the subtree of the node is skipped;
+- frequency look-ahead: if the union of head and tail is frequent,
+  it is a maximal item set and the subtree is skipped as well.
+The tail items are processed in ascending order w.r.t. their support
+(with the head), which makes the look-aheads succeed more often.
+  For the subset checks only those maximal sets are considered that
+contain the head (progressive focusing): a node receives the indices
+of the maximal sets of its parent that contain its head, and all sets
+that are found in its subtree contain its head automatically. The
+found maximal sets are stored in an item set repository.
+  The supports of the extensions are counted and their transaction
+lists are built with one pass over the transactions that contain the
+head (occurrence deliver), so that only the lists on the current path
+of the recursion are kept.
+  Items to ignore are removed and, as in the item set tree, a set may
+contain at most one head only item. Maximality is decided in this
+restricted search space: first the maximal sets with a head only item
+are found by a search for each such item, in which only the trans-
+actions containing it are considered and only the other items are
+candidates. Then the maximal sets without a head only item are found,
+with all sets found before as the initial focus, because a set that is
+a subset of one of them can be extended by its head only item.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- a tail item --- */
+  int     item;                 /* tail item (frequency rank) */
+  int     cnt;                  /* support (number of identifiers) */
+  int     *tids;                /* identifiers of the transactions */
+} GMXTAIL;                      /* (tail item) */
+
+typedef struct {                /* --- GenMax search data --- */
+  SUPP    supp;                 /* minimal support of an item set */
+  int     min;                  /* minimal size of a reported set */
+  ISREPFN *report;              /* item set report function */
+  void    *data;                /* data for the report function */
+  int     *codes;               /* map from ranks to item codes */
+  int     *set;                 /* current item set (as ranks) */
+  int     *out;                 /* buffer for reported item sets */
+  int     **tras;               /* transactions (ranks, -1 terminated) */
+  int     *cnts;                /* occurrence counters of the items */
+  int     *map;                 /* map from ranks to tail indices */
+  SETREPO *mfi;                 /* maximal item sets found so far */
+} GENMAX;                       /* (GenMax search data) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int _report (GENMAX *gmx, int cnt, SUPP supp)
+{                               /* --- report a maximal item set */
+  int i;                        /* loop variable */
+
+  assert(gmx && (cnt > 0));     /* check the function arguments */
+  for (i = cnt; --i >= 0; )     /* copy the ranks of the items */
+    gmx->out[i] = gmx->set[i];  /* and sort them (the repository */
+  ta_sort(gmx->out, cnt);       /* stores sets in ascending order) */
+  if (sr_add(gmx->mfi, gmx->out, cnt, supp) != 0)
+    return -1;                  /* store the set for subset checks */
+  if (cnt < gmx->min) return 0; /* check the size of the set */
+  for (i = cnt; --i >= 0; )     /* map the ranks to item codes */
+    gmx->out[i] = gmx->codes[gmx->set[i]];
+  ta_sort(gmx->out, cnt);       /* sort the items of the set */
+  return gmx->report(gmx->out, cnt, supp, gmx->data);
+}  /* _report() */
+
+/*--------------------------------------------------------------------*/
+
+static int _contains (GENMAX *gmx, int index, const int *items, int n)
+{                               /* --- check for a superset */
+  int i, l, r, m, k;            /* loop variable, indices, item */
+  int *s;                       /* items of the maximal set */
+
+  assert(gmx && (index >= 0) && (items || (n <= 0)));
+  s = sr_items(gmx->mfi, index);/* get the items of the set */
+  for (i = 0; i < n; i++) {     /* traverse the items to check */
+    k = items[i];               /* and do a binary search */
+    for (l = 0, r = sr_size(gmx->mfi, index); l < r; ) {
+      m = (l+r) >> 1;           /* in the sorted items */
+      if (s[m] < k) l = m+1; else r = m;
+    }                           /* if an item is missing, */
+    if ((l >= sr_size(gmx->mfi, index)) || (s[l] != k))
+      return 0;                 /* the set is no superset */
+  }
+  return 1;                     /* all items are contained */
+}  /* _contains() */
+
+/*--------------------------------------------------------------------*/
+
+static int _focus (GENMAX *gmx, int *dst, const int *src, int n,
+                   int lo, const int *items, int k)
+{                               /* --- filter the maximal sets */
+  int i, c = 0;                 /* loop variable, counter */
+
+  assert(gmx && dst && (src || (n <= 0)));
+  for (i = 0; i < n; i++)       /* keep the given sets */
+    if (_contains(gmx, src[i], items, k)) dst[c++] = src[i];
+  for (i = lo; i < sr_cnt(gmx->mfi); i++)
+    if (_contains(gmx, i, items, k)) dst[c++] = i;
+  return c;                     /* and the sets found since index lo */
+}  /* _focus() */               /* that contain the given items */
+
+/*--------------------------------------------------------------------*/
+
+static int _search (GENMAX *gmx, const int *tids, int n, int len,
+                    const int *cand, int ccnt, const int *focus, int fcnt)
+{                               /* --- recursive part of GenMax */
+  int     i, k, m, c, r = 0;    /* loop variables, buffers */
+  int     lo;                   /* number of sets at the start */
+  int     tcnt;                 /* number of tail items */
+  int     *t, *p;               /* to traverse the items/identifiers */
+  int     *cnts = gmx->cnts;    /* occurrence counters of the items */
+  int     *map  = gmx->map;     /* map from ranks to tail indices */
+  int     *items;               /* items of the tail (in order) */
+  int     *curr, *next;         /* focus of this node and a child */
+  size_t  total;                /* total size of the tail lists */
+  GMXTAIL *tail, *x;            /* tail items of the node */
+
+  assert(gmx && tids && (n > 0) && (cand || (ccnt <= 0)));
+  lo = sr_cnt(gmx->mfi);        /* note the number of maximal sets */
+  for (i = 0; i < ccnt; i++) map[cand[i]] = 0;
+  for (k = n; --k >= 0; )       /* count the candidate items */
+    for (t = gmx->tras[tids[k]]; *t >= 0; t++)
+      if (map[*t] >= 0) cnts[*t]++;
+  for (m = len, tcnt = 0, total = 0, i = 0; i < ccnt; i++) {
+    k = cand[i]; map[k] = -1;   /* traverse the candidate items */
+    if      (cnts[k] >= n)            gmx->set[m++] = k;
+    else if (cnts[k] >= gmx->supp) {  /* add items with the same */
+      tcnt++; total += (size_t)cnts[k]; }  /* support to the head */
+  }                             /* and collect the tail items */
+  tail = (GMXTAIL*)malloc(tcnt *sizeof(GMXTAIL)
+                         +(tcnt +fcnt +1) *sizeof(int) +total *sizeof(int));
+  if (!tail) {                  /* create the tail and focus vectors */
+    for (i = 0; i < ccnt; i++) cnts[cand[i]] = 0;
+    return -1;                  /* on failure clear the counters */
+  }                             /* and abort the search */
+  items = (int*)(tail +tcnt);   /* (tail items, focus, identifiers) */
+  curr  = items +tcnt;          /* (head items added by parent */
+  p     = curr  +fcnt +1;       /* equivalence are also contained */
+  fcnt  = _focus(gmx, curr, focus, fcnt, lo, gmx->set +len, m -len);
+  for (x = tail, i = 0; i < ccnt; i++) {
+    k = cand[i];                /* in the maximal sets of the focus) */
+    if ((cnts[k] >= gmx->supp) && (cnts[k] < n)) {
+      for (r = (int)(x -tail); (--r >= 0) && (tail[r].cnt > cnts[k]); )
+        tail[r+1] = tail[r];    /* insert the tail items */
+      tail[r+1].item = k;       /* in ascending order w.r.t. */
+      tail[r+1].cnt  = cnts[k]; /* their support (insertion sort */
+      x++;                      /* keeps the order of items with */
+    }                           /* equal support) */
+    cnts[k] = 0;                /* clear the occurrence counters */
+  }
+  r = 0;                        /* init. the error status */
+  if (tcnt <= 0) {              /* if the tail is empty, */
+    if ((fcnt <= 0) && (m > 0)) /* the head is maximal */
+      r = _report(gmx, m, (SUPP)n);   /* if it is not a subset */
+    free(tail); return r;       /* of a known maximal set */
+  }
+  for (i = 0; i < tcnt; i++)    /* collect the tail items */
+    items[i] = tail[i].item;    /* (in the processing order) */
+  for (i = 0; i < fcnt; i++)    /* superset look-ahead: */
+    if (_contains(gmx, curr[i], items, tcnt)) break;
+  if (i < fcnt) { free(tail); return 0; }
+  for (i = 0; i < tcnt; i++) map[items[i]] = i;
+  for (c = 0, k = n; (--k >= 0) && (c +k +1 >= gmx->supp); ) {
+    for (i = 0, t = gmx->tras[tids[k]]; *t >= 0; t++)
+      if (map[*t] >= 0) i++;    /* frequency look-ahead: count the */
+    if (i >= tcnt) c++;         /* transactions with all tail items */
+  }                             /* (stop if the support is too low) */
+  if (c >= gmx->supp) {         /* if head and tail are frequent, */
+    for (i = 0; i < tcnt; i++) {/* add the tail to the head */
+      gmx->set[m+i] = items[i]; map[items[i]] = -1; }
+    r = _report(gmx, m +tcnt, (SUPP)c);
+    free(tail); return r;       /* report the union */
+  }                             /* as a maximal item set */
+  for (i = 0; i < tcnt; i++) {  /* initialize the tail lists */
+    tail[i].tids = p; p += tail[i].cnt; tail[i].cnt = 0; }
+  for (k = 0; k < n; k++)       /* deliver the identifiers */
+    for (t = gmx->tras[tids[k]]; *t >= 0; t++)
+      if (map[*t] >= 0) {       /* traverse the transactions */
+        x = tail +map[*t];      /* and add their identifiers */
+        x->tids[x->cnt++] = tids[k];
+      }                         /* to the lists of the tail items */
+  for (i = 0; i < tcnt; i++) map[items[i]] = -1;
+  for (i = 0; (r >= 0) && (i < tcnt); i++) {
+    next = (int*)malloc((fcnt +sr_cnt(gmx->mfi) -lo +1) *sizeof(int));
+    if (!next) { r = -1; break; }
+    c = _focus(gmx, next, curr, fcnt, lo, items +i, 1);
+    gmx->set[m] = items[i];     /* extend the head by the tail item */
+    r = _search(gmx, tail[i].tids, tail[i].cnt, m+1,
+                items +i+1, tcnt -i-1, next, c);
+    free(next);                 /* process the extended head */
+  }                             /* recursively with the remaining */
+  free(tail);                   /* tail items as candidates */
+  return r;                     /* return the error status */
+}  /* _search() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int gmx_mine (TASET *taset, SUPP supp, int min,
+              ISREPFN *report, void *data)
+{                               /* --- find maximal item sets */
+  int     i, k, n, m;           /* loop variables, numbers of items */
+  int     *ranks, *p, *s;       /* item ranks, to traverse the items */
+  int     *tids, *htids;        /* identifiers of (all) transactions */
+  int     *focus;               /* maximal sets with head only items */
+  int     h, c, t;              /* head only item, number of */
+                                /* candidates and of transactions */
+  SUPP    *frqs;                /* item frequencies */
+  ITEMSET *iset;                /* item set of the transactions */
+  GENMAX  gmx;                  /* search data */
+
+  assert(taset && report && (min > 0));
+  iset = tas_itemset(taset);    /* get the item set and */
+  n    = is_cnt(iset);          /* the number of items */
+  if ((n <= 0) || (tas_cnt(taset) <= 0) || (tas_cnt(taset) < supp))
+    return 0;                   /* check for a possible result */
+  frqs = (SUPP*)calloc(n, sizeof(SUPP) +6*sizeof(int));
+  if (!frqs) return -1;         /* create the item vectors */
+  ranks     = (int*)(frqs +n);  /* (frequencies, ranks, codes, */
+  gmx.codes = ranks +n;         /* current item set, output buffer, */
+  gmx.set   = gmx.codes +n;     /* counters, tail map) */
+  gmx.out   = gmx.set   +n;
+  gmx.cnts  = gmx.out   +n;
+  gmx.map   = gmx.cnts  +n;
+  for (i = tas_cnt(taset); --i >= 0; )
+    for (s = tas_tract(taset, i), k = tas_tsize(taset, i); --k >= 0; )
+      frqs[s[k]]++;             /* determine the item frequencies */
+  gmx.supp = (supp > 0) ? supp : 1;
+  for (m = i = 0; i < n; i++)   /* collect the frequent items */
+    if ((frqs[i] >= gmx.supp) && (is_getapp(iset, i) != APP_NONE))
+      gmx.codes[m++] = i;       /* (except items to ignore) */
+  for (i = 1; i < m; i++) {     /* sort the frequent items */
+    k = gmx.codes[i];           /* ascendingly w.r.t. frequency */
+    for (p = gmx.codes +i; (--p >= gmx.codes) && (frqs[*p] > frqs[k]); )
+      p[1] = *p;                /* (insertion sort keeps the order */
+    p[1] = k;                   /* of items with equal frequency) */
+  }
+  for (i = 0; i < n; i++) ranks[i] = gmx.map[i] = -1;
+  for (i = 0; i < m; i++) ranks[gmx.codes[i]] = i;
+  gmx.mfi  = sr_create();       /* create a repository for the */
+  gmx.tras = (int**)malloc(tas_cnt(taset) *sizeof(int*)
+                          +(tas_total(taset) +3*tas_cnt(taset) +m)
+                          *sizeof(int));
+  if (!gmx.mfi || !gmx.tras) {  /* maximal sets and transactions */
+    if (gmx.mfi) sr_delete(gmx.mfi);
+    free(gmx.tras); free(frqs); return -1;
+  }
+  tids  = (int*)(gmx.tras +tas_cnt(taset));
+  htids = tids  +tas_cnt(taset);
+  p     = htids +tas_cnt(taset);/* create the transaction vectors */
+  for (i = 0; i < tas_cnt(taset); i++) {
+    s = tas_tract(taset, i);    /* traverse the transactions */
+    for (gmx.tras[i] = p, k = tas_tsize(taset, i); --k >= 0; )
+      if (ranks[s[k]] >= 0) *p++ = ranks[s[k]];
+    *p++ = -1; tids[i] = i;     /* replace the items by their ranks, */
+  }                             /* store a sentinel, note identifier */
+  for (c = i = 0; i < m; i++)   /* all items that are not head only */
+    if (is_getapp(iset, gmx.codes[i]) != APP_HEAD)
+      p[c++] = i;               /* are candidates */
+  gmx.min    = min;             /* note the search parameters */
+  gmx.report = report;
+  gmx.data   = data;
+  for (k = 0, h = 0; (k >= 0) && (h < m); h++) {
+    if (is_getapp(iset, gmx.codes[h]) != APP_HEAD)
+      continue;                 /* traverse the head only items */
+    for (t = i = 0; i < tas_cnt(taset); i++)
+      for (s = gmx.tras[i]; *s >= 0; s++)
+        if (*s == h) { htids[t++] = i; break; }
+    gmx.set[0] = h;             /* collect the transactions */
+    k = _search(&gmx, htids, t, 1, p, c, NULL, 0);
+  }                             /* and find the maximal sets with */
+  focus = NULL;                 /* the item (the item is frequent) */
+  if ((k >= 0) && (sr_cnt(gmx.mfi) > 0)) {
+    focus = (int*)malloc(sr_cnt(gmx.mfi) *sizeof(int));
+    if (!focus) k = -1;         /* use all maximal sets found so far */
+    else for (i = 0; i < sr_cnt(gmx.mfi); i++) focus[i] = i;
+  }                             /* as the initial focus */
+  if (k >= 0)                   /* find the maximal sets without */
+    k = _search(&gmx, tids, tas_cnt(taset), 0, p, c,   /* head only */
+                focus, (focus) ? sr_cnt(gmx.mfi) : 0); /* items */
+  free(focus);                  /* delete the initial focus */
+  sr_delete(gmx.mfi);           /* find maximal item sets recursively */
+  free(gmx.tras);               /* and delete the repository, */
+  free(frqs);                   /* the transactions and */
+  return k;                     /* the item vectors */
+}  /* gmx_mine() */
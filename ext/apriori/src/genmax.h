@@ -0,0 +1,17 @@
+/*----------------------------------------------------------------------
+  File    : genmax.h
+  Contents: GenMax algorithm for finding maximal item sets
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __GENMAX__
+#define __GENMAX__
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int gmx_mine (TASET *taset, SUPP supp, int min,
+                     ISREPFN *report, void *data);
+
+#endif
@@ -0,0 +1,238 @@
+/*----------------------------------------------------------------------
+  File    : hshtree.c
+  Contents: hash tree management (candidate item sets)
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "hshtree.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE    256          /* block size for candidate vectors */
+#define HASH(i)    ((unsigned)(i) % HT_FANOUT)    /* hash function */
+
+/*----------------------------------------------------------------------
+  The hash tree is the classic data structure for counting candidate
+item sets (Agrawal and Srikant 1994). Each candidate is stored in
+exactly one leaf, which is found by hashing the first, second etc.
+item of the candidate in the inner nodes. A leaf is split into an
+inner node (with HT_FANOUT children) if it holds more than HT_LEAFMAX
+candidates and the depth of the leaf is less than the candidate size.
+  To find the candidates contained in a transaction, the tree is
+descended by hashing each item of the transaction that leaves enough
+items for the rest of a candidate. Since hash collisions can lead to
+the same leaf on different paths, each leaf notes the stamp of the
+last transaction that visited it, so that its candidates are checked
+only once. A candidate is contained in the transaction if all of its
+items are marked with the stamp of the transaction.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static void _delete (HTNODE *node)
+{                               /* --- recursively delete a subtree */
+  int i;                        /* loop variable */
+
+  assert(node);                 /* check the function argument */
+  if (node->cnt < 0) {          /* if the node is an inner node, */
+    for (i = HT_FANOUT; --i >= 0; )  /* delete all children */
+      if (node->chs[i]) _delete(node->chs[i]);
+    free(node->chs); }          /* delete the child vector */
+  else                          /* if the node is a leaf, */
+    free(node->cands);          /* delete the candidate vector */
+  free(node);                   /* delete the node itself */
+}  /* _delete() */
+
+/*--------------------------------------------------------------------*/
+
+static void _clear (HTNODE *node)
+{                               /* --- recursively clear stamps */
+  int i;                        /* loop variable */
+
+  assert(node);                 /* check the function argument */
+  node->stamp = 0;              /* clear the transaction stamp */
+  if (node->cnt < 0)            /* if the node is an inner node, */
+    for (i = HT_FANOUT; --i >= 0; )  /* clear all children */
+      if (node->chs[i]) _clear(node->chs[i]);
+}  /* _clear() */
+
+/*--------------------------------------------------------------------*/
+
+static int _insert (HTREE *ht, HTNODE *node, int c, int depth);
+
+static int _split (HTREE *ht, HTNODE *node, int depth)
+{                               /* --- split a leaf */
+  int    i, n;                  /* loop variable, number of cands. */
+  int    *cands;                /* candidates of the leaf */
+  HTNODE **p;                   /* to access the child nodes */
+
+  assert(ht && node && (node->cnt >= 0) && (depth < ht->size));
+  p = (HTNODE**)calloc(HT_FANOUT, sizeof(HTNODE*));
+  if (!p) return -1;            /* create a child vector */
+  cands = node->cands;          /* note the candidates */
+  n     = node->cnt;            /* and their number and */
+  node->cnt   = -1;             /* turn the leaf into an inner node */
+  node->vsz   = 0;
+  node->cands = NULL;
+  node->chs   = p;
+  for (i = 0; i < n; i++) {     /* traverse the candidates */
+    p = node->chs +HASH(ht->items[cands[i] *ht->size +depth]);
+    if (!*p && !(*p = (HTNODE*)calloc(1, sizeof(HTNODE)))) {
+      free(cands); return -1; } /* get or create the child */
+    if (_insert(ht, *p, cands[i], depth+1) != 0) {
+      free(cands); return -1; } /* distribute the candidates */
+  }                             /* to the children */
+  free(cands);                  /* delete the old candidate vector */
+  return 0;                     /* return 'ok' */
+}  /* _split() */
+
+/*--------------------------------------------------------------------*/
+
+static int _insert (HTREE *ht, HTNODE *node, int c, int depth)
+{                               /* --- insert a candidate into a leaf */
+  int n;                        /* new size of the candidate vector */
+  int *p;                       /* new candidate vector */
+
+  assert(ht && node && (node->cnt >= 0));
+  if (node->cnt >= node->vsz) { /* if the candidate vector is full */
+    n = (node->vsz > 0) ? node->vsz +node->vsz : 4;
+    p = (int*)realloc(node->cands, n *sizeof(int));
+    if (!p) return -1;          /* enlarge the candidate vector */
+    node->cands = p; node->vsz = n;
+  }                             /* set the new vector and its size */
+  node->cands[node->cnt++] = c; /* add the candidate to the leaf */
+  if ((node->cnt > HT_LEAFMAX) && (depth < ht->size))
+    return _split(ht, node, depth);
+  return 0;                     /* split the leaf if it is too full */
+}  /* _insert() */              /* and items for hashing are left */
+
+/*--------------------------------------------------------------------*/
+
+static void _match (HTREE *ht, HTNODE *node,
+                    const int *items, int n, int depth)
+{                               /* --- find contained candidates */
+  int    i, k;                  /* loop variables */
+  int    *p;                    /* items of a candidate */
+  HTNODE *child;                /* child node to descend to */
+
+  assert(ht && node && (n >= 0));
+  if (node->cnt >= 0) {         /* if the node is a leaf */
+    if (node->stamp == ht->stamp)
+      return;                   /* check each leaf only once */
+    node->stamp = ht->stamp;    /* for every transaction */
+    for (i = node->cnt; --i >= 0; ) {
+      p = ht->items +node->cands[i] *ht->size;
+      for (k = ht->size; --k >= 0; )
+        if (ht->marks[p[k]] != ht->stamp) break;
+      if (k < 0)                /* if all items are marked, note */
+        ht->hits[ht->hcnt++] = ht->data[node->cands[i]];
+    }                           /* the data of the candidate */
+    return;                     /* (the candidate is contained */
+  }                             /* in the current transaction) */
+  k = n -(ht->size -depth);     /* get the last usable position */
+  for (i = 0; i <= k; i++) {    /* traverse the transaction's items */
+    child = node->chs[HASH(items[i])];
+    if (child) _match(ht, child, items+i+1, n-i-1, depth+1);
+  }                             /* descend to the child of each item */
+}  /* _match() */               /* and find candidates recursively */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+HTREE* ht_create (int size, int itemcnt)
+{                               /* --- create a hash tree */
+  HTREE *ht;                    /* created hash tree */
+
+  assert((size > 0) && (itemcnt > 0));  /* check the arguments */
+  ht = (HTREE*)malloc(sizeof(HTREE));
+  if (!ht) return NULL;         /* allocate the tree body */
+  ht->marks = (int*)calloc(itemcnt+itemcnt, sizeof(int));
+  if (!ht->marks) { free(ht); return NULL; }
+  ht->buf   = ht->marks +itemcnt;   /* create marker and t.a. buffer */
+  ht->root  = (HTNODE*)calloc(1, sizeof(HTNODE));
+  if (!ht->root) { free(ht->marks); free(ht); return NULL; }
+  ht->size    = size;           /* create an empty root leaf */
+  ht->itemcnt = itemcnt;        /* and initialize the fields */
+  ht->cnt     = ht->vsz = 0;
+  ht->items   = NULL;
+  ht->data    = ht->hits = NULL;
+  ht->hcnt    = ht->stamp = 0;
+  return ht;                    /* return the created hash tree */
+}  /* ht_create() */
+
+/*--------------------------------------------------------------------*/
+
+void ht_delete (HTREE *ht)
+{                               /* --- delete a hash tree */
+  assert(ht);                   /* check the function argument */
+  _delete(ht->root);            /* delete the nodes, */
+  if (ht->items) free(ht->items);  /* the candidate items, */
+  if (ht->data)  free(ht->data);   /* the candidate data, */
+  free(ht->marks);              /* the item markers, */
+  free(ht);                     /* and the tree body */
+}  /* ht_delete() */
+
+/*--------------------------------------------------------------------*/
+
+int ht_add (HTREE *ht, const int *items, void *data)
+{                               /* --- add a candidate item set */
+  int    n, depth;              /* new vector size, node depth */
+  HTNODE *node;                 /* to traverse the nodes */
+  HTNODE **p;                   /* to access the child nodes */
+  void   *t;                    /* temporary buffer */
+
+  assert(ht && items);          /* check the function arguments */
+  if (ht->cnt >= ht->vsz) {     /* if the candidate vectors are full */
+    n = ht->vsz +((ht->vsz > BLKSIZE) ? ht->vsz >> 1 : BLKSIZE);
+    t = realloc(ht->items, n *ht->size *sizeof(int));
+    if (!t) return -1;          /* enlarge the item vector */
+    ht->items = (int*)t;        /* and set the new vector */
+    t = realloc(ht->data, (n+n) *sizeof(void*));
+    if (!t) return -1;          /* enlarge the data vector */
+    ht->data = (void**)t;       /* (hits are stored behind the data) */
+    ht->hits = ht->data +n;     /* set the new vectors */
+    ht->vsz  = n;               /* and their size */
+  }
+  memcpy(ht->items +ht->cnt *ht->size, items, ht->size *sizeof(int));
+  ht->data[ht->cnt] = data;     /* store the candidate and its data */
+  for (node = ht->root, depth = 0; node->cnt < 0; depth++) {
+    p = node->chs +HASH(items[depth]);
+    if (!*p && !(*p = (HTNODE*)calloc(1, sizeof(HTNODE))))
+      return -1;                /* get or create the child node */
+    node = *p;                  /* for the next item and */
+  }                             /* go down to this child */
+  if (_insert(ht, node, ht->cnt, depth) != 0)
+    return -1;                  /* insert the candidate into the leaf */
+  return ht->cnt++;             /* return the candidate index */
+}  /* ht_add() */
+
+/*--------------------------------------------------------------------*/
+
+int ht_match (HTREE *ht, const int *items, int n)
+{                               /* --- find contained candidates */
+  int i;                        /* loop variable */
+
+  assert(ht                     /* check the function arguments */
+     && (n >= 0) && (items || (n <= 0)));
+  ht->hcnt = 0;                 /* clear the number of hits */
+  if (n < ht->size) return 0;   /* check the transaction size */
+  if (++ht->stamp <= 0) {       /* if the stamps wrapped around, */
+    memset(ht->marks, 0, ht->itemcnt *sizeof(int));
+    _clear(ht->root);           /* clear all markers and stamps */
+    ht->stamp = 1;              /* and restart with the first stamp */
+  }
+  for (i = n; --i >= 0; )       /* mark the items of the transaction */
+    ht->marks[items[i]] = ht->stamp;
+  _match(ht, ht->root, items, n, 0);
+  return ht->hcnt;              /* find the contained candidates */
+}  /* ht_match() */             /* and return their number */
@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------
+  File    : hshtree.h
+  Contents: hash tree management (candidate item sets)
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __HSHTREE__
+#define __HSHTREE__
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define HT_FANOUT   16          /* number of children of inner nodes */
+#define HT_LEAFMAX  32          /* maximal number of cands. in a leaf */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct _htnode {        /* --- hash tree node --- */
+  int            cnt;           /* number of candidates (-1: inner) */
+  int            vsz;           /* size of candidate index vector */
+  int            stamp;         /* stamp of last visiting transaction */
+  int            *cands;        /* candidate indices (leaf only) */
+  struct _htnode **chs;         /* child nodes (inner node only) */
+} HTNODE;                       /* (hash tree node) */
+
+typedef struct {                /* --- hash tree --- */
+  int     size;                 /* size of the candidate item sets */
+  int     itemcnt;              /* number of items */
+  int     cnt;                  /* number of candidates */
+  int     vsz;                  /* size of the candidate vectors */
+  int     *items;               /* items of the candidates */
+  void    **data;               /* data associated with candidates */
+  void    **hits;               /* data of contained candidates */
+  int     hcnt;                 /* number of contained candidates */
+  int     stamp;                /* stamp of the current transaction */
+  int     *marks;               /* transaction stamps of the items */
+  int     *buf;                 /* buffer for a transaction */
+  HTNODE  *root;                /* root node of the tree */
+} HTREE;                        /* (hash tree) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern HTREE*  ht_create (int size, int itemcnt);
+extern void    ht_delete (HTREE *ht);
+extern int     ht_add    (HTREE *ht, const int *items, void *data);
+extern int     ht_cnt    (HTREE *ht);
+extern int     ht_size   (HTREE *ht);
+extern int     ht_match  (HTREE *ht, const int *items, int n);
+extern void**  ht_hits   (HTREE *ht);
+extern int*    ht_buf    (HTREE *ht);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define ht_cnt(t)         ((t)->cnt)
+#define ht_size(t)        ((t)->size)
+#define ht_hits(t)        ((t)->hits)
+#define ht_buf(t)         ((t)->buf)
+
+#endif
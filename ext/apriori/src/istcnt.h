@@ -0,0 +1,332 @@
+/*----------------------------------------------------------------------
+  File    : istcnt.h
+  Contents: item set tree counting functions (for one counter width)
+  Author  : Christian Borgelt
+  History : 2026.10.19 file created from istree.c
+            2026.10.19 counted level selected by minimal size
+            2026.10.19 function _cnttri added (triangular array)
+----------------------------------------------------------------------*/
+/* This file is included by istree.c once for each counter width.    */
+/* Before it is included, CNT must be defined as the counter type and */
+/* CWD as the number of bits of this type, which is appended to the   */
+/* names of all functions defined here (e.g. _count16, _count32).     */
+/*--------------------------------------------------------------------*/
+#define KN_(f,w)   f##w         /* paste function name and width */
+#define KN__(f,w)  KN_(f,w)     /* (expand the width first) */
+#define KN(f)      KN__(f,CWD)  /* function name for counter width */
+
+/*----------------------------------------------------------------------
+  Counting Functions
+----------------------------------------------------------------------*/
+
+static void KN(_count) (ISNODE *node, int *set, int cnt,
+                        int min, int wgt, void *shd)
+{                               /* --- count transaction recursively */
+  int    i, k, e;               /* vector and transaction indices */
+  int    a, b;                  /* items to compare (merge) */
+  int    *map, n;               /* identifier map and its size */
+  int    *sx;                   /* search index of the map */
+  CNT    *cnts;                 /* counter vector (or its shadow) */
+  ISNODE **vec;                 /* child node vector */
+
+  assert(node                   /* check the function arguments */
+      && (cnt >= 0) && (set || (cnt <= 0)));
+  if (node->offset >= 0) {      /* if a pure vector is used */
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      n = node->offset;         /* get the index offset */
+      if (cnt > LB_LINEAR) {    /* if the transaction is long, */
+        k = _lbound(set, cnt, n);   /* clip it to the counter range */
+        e = _lbound(set, cnt, n +node->size); }  /* by searching */
+      else {                    /* if the transaction is short, */
+        k = 0; while ((k < cnt) && (set[k] < n)) k++;
+        e = k; while ((e < cnt) && (set[e] < n +node->size)) e++;
+      }                         /* clip it with simple loops */
+      for ( ; k < e; k++)       /* count the transaction */
+        CNTADD(shd, cnts[set[k] -n], wgt); }
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;
+      n   = ID(vec[0]);         /* get the child node vector */
+      min--;                    /* one item less to the deepest nodes */
+      if ((e = cnt -min) <= 0) return;
+      if (e > LB_LINEAR) {      /* if the transaction is long, */
+        k = _lbound(set, e, n); /* clip it to the child range */
+        e = _lbound(set, e, n +node->chcnt); }   /* by searching */
+      else {                    /* if the transaction is short, */
+        i = e; k = 0; while ((k < i) && (set[k] < n)) k++;
+        e = k; while ((e < i) && (set[e] < n +node->chcnt)) e++;
+      }                         /* clip it with simple loops */
+      for ( ; k < e; k++)       /* traverse the transaction's items */
+        if (vec[set[k] -n])     /* if the child exists, count */
+          KN(_count)(vec[set[k] -n], set+k+1, cnt-k-1, min, wgt, shd);
+    } }                         /* the transaction recursively */
+  else {                        /* if an identifer map is used */
+    n   = node->size;           /* get the identifier map */
+    map = MAP(node, sizeof(CNT));
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      if (n <= MG_RATIO *cnt) { /* if the map is not much longer, */
+        for (i = k = 0; (k < cnt) && (i < n); ) {
+          a = set[k]; b = map[i];  /* intersect the transaction */
+          if (a == b) CNTADD(shd, cnts[i], wgt);    /* and the map */
+          k += (a <= b); i += (b <= a);
+        } }                     /* (merge-style, two pointers) */
+      else {                    /* if the map is much longer */
+        sx = (node->offset < -1) ? map +n : NULL;
+        for (i = k = 0; (k < cnt) && (i < n); k++) {
+          i = (sx) ? _sxlbound(map, n, sx, set[k])
+                   : i +_lbound(map+i, n-i, set[k]);
+          if ((i < n) && (map[i] == set[k]))
+            CNTADD(shd, cnts[i], wgt);
+        }                       /* find the index of each item */
+      } }                       /* and count the transaction */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;        /* get the child vector */
+      if (node->chcnt < n)      /* if a secondary id. map exists */
+        map = (int*)(vec +(n = node->chcnt));
+      min--;                    /* one item less to the deepest nodes */
+      e = cnt -min;             /* get the number of items to check */
+      if (n <= MG_RATIO *e) {   /* if the map is not much longer, */
+        for (i = k = 0; (k < e) && (i < n); ) {
+          a = set[k]; b = map[i];  /* intersect the transaction */
+          if ((a == b) && vec[i])  /* and the map (merge-style) */
+            KN(_count)(vec[i], set+k+1, cnt-k-1, min, wgt, shd);
+          k += (a <= b); i += (b <= a);
+        } }                     /* count the transaction recursively */
+      else {                    /* if the map is much longer */
+        sx = ((node->offset < -1) && (n == node->size))
+           ? map +n : NULL;
+        for (i = k = 0; (k < e) && (i < n); k++) {
+          i = (sx) ? _sxlbound(map, n, sx, set[k])
+                   : i +_lbound(map+i, n-i, set[k]);
+          if ((i < n) && (map[i] == set[k]) && vec[i])
+            KN(_count)(vec[i], set+k+1, cnt-k-1, min, wgt, shd);
+        }                       /* find the index of each item */
+      }                         /* and if the child exists, */
+    }                           /* count the transaction recursively */
+  }
+}  /* _count() */
+
+/*--------------------------------------------------------------------*/
+
+static void KN(_countx) (ISNODE *node, TATREE *tat, int min,
+                         void *shd);
+
+static void KN(_countp) (ISNODE *node, TATREE *tat, int off,
+                         int min, void *shd)
+{                               /* --- count a path node recursively */
+  int    i, k;                  /* vector index, loop variable */
+  int    *items, cnt;           /* items on the path and their number */
+  int    *map, n;               /* identifier map and its size */
+  CNT    *cnts;                 /* counter vector (or its shadow) */
+  ISNODE **vec;                 /* child node vector */
+  TATREE *tail;                 /* subtree below the path */
+
+  assert(node && tat && (tat_size(tat) < 0) && (off >= 0));
+  if (tat_max(tat) -off < min)  /* if the transactions are too short, */
+    return;                     /* abort the recursion */
+  items = tat_items(tat) +off;  /* get the rest of the path */
+  cnt   = -tat_size(tat) -off;  /* and the number of its items */
+  tail  = tat_tail(tat);        /* if all transactions end with */
+  if (!tail) {                  /* the path, count them linearly */
+    KN(_count)(node, items, cnt, min, tat_cnt(tat), shd); return; }
+  KN(_countx)(node, tail, min, shd);/* count the subtree below the path */
+  if (node->offset >= 0) {      /* if a pure vector is used */
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      n = node->offset;         /* get the index offset */
+      for (k = 0; k < cnt; k++){/* traverse the items on the path */
+        i = items[k] -n;        /* compute counter vector index */
+        if (i <  0) continue;   /* skip items before first counter */
+        if (i >= node->size) return;
+        CNTADD(shd, cnts[i], tat_cnt(tat));
+      } }                       /* count the transactions */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;
+      n   = ID(vec[0]);         /* get the child node vector */
+      for (k = 0; k < cnt; k++){/* traverse the items on the path */
+        i = items[k] -n;        /* compute child vector index */
+        if (i <  0) continue;   /* skip items before first child */
+        if (i >= node->chcnt) return;
+        if (vec[i]) KN(_countp)(vec[i], tat, off+k+1, min-1, shd);
+      }                         /* if the child exists, */
+    } }                         /* count the transactions recursively */
+  else {                        /* if an identifer map is used */
+    n   = node->size;           /* get the identifier map */
+    map = MAP(node, sizeof(CNT));
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      for (k = 0; k < cnt; k++){/* traverse the items on the path */
+        if (items[k] > map[n-1]) return; /* if beyond last item, abort */
+        i = _search(node, map, n, items[k]);
+        if (i >= 0) CNTADD(shd, cnts[i], tat_cnt(tat));
+      } }                       /* find index and count transactions */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;        /* get the child vector */
+      if (node->chcnt < n)      /* if a secondary id. map exists */
+        map = (int*)(vec +(n = node->chcnt));
+      for (k = 0; k < cnt; k++){/* traverse the items on the path */
+        if (items[k] > map[n-1]) return; /* if beyond last item, abort */
+        i = _search(node, map, n, items[k]);
+        if ((i >= 0) && vec[i]) KN(_countp)(vec[i], tat, off+k+1, min-1, shd);
+      }                         /* search for the proper index */
+    }                           /* and if the child exists, */
+  }                             /* count the transactions recursively */
+}  /* _countp() */
+
+/*--------------------------------------------------------------------*/
+
+static void KN(_countx) (ISNODE *node, TATREE *tat, int min,
+                         void *shd)
+{                               /* --- count transa. tree recursively */
+  int    i, k;                  /* vector index, loop variable */
+  int    *map, n;               /* identifier map and its size */
+  CNT    *cnts;                 /* counter vector (or its shadow) */
+  ISNODE **vec;                 /* child node vector */
+
+  assert(node && tat);          /* check the function arguments */
+  if (tat_max(tat) < min)       /* if the transactions are too short, */
+    return;                     /* abort the recursion */
+  k = tat_size(tat);            /* get the number of children */
+  if (k <= 0) {                 /* if this is a path node, */
+    if (k < 0) KN(_countp)(node, tat, 0, min, shd);
+    return;                     /* count its transactions */
+  }                             /* and abort the function */
+  while (--k >= 0)              /* count the transactions recursively */
+    KN(_countx)(node, tat_child(tat, k), min, shd);
+  if (node->offset >= 0) {      /* if a pure vector is used */
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      n = node->offset;         /* get the index offset */
+      for (k = tat_size(tat); --k >= 0; ) {
+        i = tat_item(tat,k) -n; /* traverse the items */
+        if (i < 0) return;      /* if before first item, abort */
+        if (i < node->size)     /* if inside the counter range */
+          CNTADD(shd, cnts[i], tat_cnt(tat_child(tat, k)));
+      } }                       /* count the transaction */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;
+      n   = ID(vec[0]);         /* get the child node vector */
+      min--;                    /* one item less to the deepest nodes */
+      for (k = tat_size(tat); --k >= 0; ) {
+        i = tat_item(tat,k) -n; /* traverse the items */
+        if (i < 0) return;      /* if before first item, abort */
+        if ((i < node->chcnt) && vec[i])
+          KN(_countx)(vec[i], tat_child(tat, k), min, shd);
+      }                         /* if the child exists, */
+    } }                         /* count the transaction recursively */
+  else {                        /* if an identifer map is used */
+    n   = node->size;           /* get the identifier map */
+    map = MAP(node, sizeof(CNT));
+    if (min <= 1) {             /* if the level is to be counted */
+      cnts = CNTS(node, shd, CNT);
+      for (k = tat_size(tat); --k >= 0; ) {
+        i = tat_item(tat, k);   /* get the next item */
+        if (i < map[0]) return; /* if before first item, abort */
+        i = _search(node, map, n, i);
+        if (i >= 0) CNTADD(shd, cnts[i], tat_cnt(tat_child(tat,k)));
+      } }                       /* find index and count transaction */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;        /* get the child vector */
+      if (node->chcnt < n)      /* if a secondary id. map exists */
+        map = (int*)(vec +(n = node->chcnt));
+      min--;                    /* one item less to the deepest nodes */
+      for (k = tat_size(tat); --k >= 0; ) {
+        i = tat_item(tat, k);   /* get the next item */
+        if (i < map[0]) return; /* if before first item, abort */
+        i = _search(node, map, n, i);
+        if ((i >= 0) && vec[i])
+          KN(_countx)(vec[i], tat_child(tat, k), min, shd);
+      }                         /* search for the proper index */
+    }                           /* and if the child exists, */
+  }                             /* count the transaction recursively */
+}  /* _countx() */
+
+/*--------------------------------------------------------------------*/
+
+static void KN(_cnttri) (void *tri, const size_t *ofs,
+                         const int *set, int beg, int cnt, int wgt)
+{                               /* --- count pairs in triangular array */
+  int    a, b, k;               /* indices of the items of a pair */
+  CNT    *row;                  /* row of the triangular array */
+
+  assert(tri && ofs && set && (beg >= 0));
+  for (a = 0; a < cnt-1; a++) { /* traverse the first items */
+    row = (CNT*)tri +ofs[set[a]];     /* get the row of the item */
+    k   = set[a] +1;            /* (starts with the next item) */
+    for (b = (a < beg) ? beg : a+1; b < cnt; b++)
+      row[set[b] -k] += (CNT)wgt;  /* count the pairs with the */
+  }                             /* items that follow it, but only */
+}  /* _cnttri() */              /* pairs with a new second item */
+
+/*--------------------------------------------------------------------*/
+#ifndef NOTHREADS
+
+static void KN(_countc) (ISNODE *node, TATREE *tat, int k,
+                         int min, void *shd)
+{                               /* --- count a child of t.a. root */
+  int    i;                     /* vector index */
+  int    *map, n;               /* identifier map and its size */
+  CNT    *cnts;                 /* counter vector (or its shadow) */
+  ISNODE **vec;                 /* child node vector */
+  TATREE *child;                /* child of the transaction tree */
+
+  assert(node && tat && (k >= 0) && (k < tat_size(tat)));
+  child = tat_child(tat, k);    /* count the subtree of the child */
+  KN(_countx)(node, child, min, shd);       /* with the item set root, */
+  i = tat_item(tat, k);         /* then count the transactions that */
+  if (node->offset >= 0) {      /* contain the item leading to it */
+    if (min <= 1) {             /* if the level is to be counted */
+      i -= node->offset;        /* compute counter vector index */
+      if ((i >= 0) && (i < node->size)) {
+        cnts = CNTS(node, shd, CNT);
+        CNTADD(shd, cnts[i], tat_cnt(child));
+      } }                       /* count the transactions */
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;
+      i  -= ID(vec[0]);         /* compute child vector index */
+      if ((i >= 0) && (i < node->chcnt) && vec[i])
+        KN(_countx)(vec[i], child, min-1, shd);
+    } }                         /* count the subtree recursively */
+  else {                        /* if an identifer map is used */
+    n   = node->size;           /* get the identifier map */
+    map = MAP(node, sizeof(CNT));
+    if (min <= 1) {             /* if the level is to be counted */
+      i = _search(node, map, n, i);  /* find the counter index */
+      if (i >= 0) {             /* and count the transactions */
+        cnts = CNTS(node, shd, CNT);
+        CNTADD(shd, cnts[i], tat_cnt(child));
+      } }
+    else if (node->chcnt > 0) { /* if there are child nodes */
+      vec = node->chvec;        /* get the child vector */
+      if (node->chcnt < n)      /* if a secondary id. map exists */
+        map = (int*)(vec +(n = node->chcnt));
+      i = _search(node, map, n, i);  /* find the child index */
+      if ((i >= 0) && vec[i]) KN(_countx)(vec[i], child, min-1, shd);
+    }                           /* and if the child exists, */
+  }                             /* count the subtree recursively */
+}  /* _countc() */
+
+/*--------------------------------------------------------------------*/
+
+static void KN(_reduce) (ISNODE *node, void *shd)
+{                               /* --- add counter shadow to node */
+  int i;                        /* loop variable */
+  CNT *src, *dst;               /* to traverse the counters */
+
+  assert(node && shd);          /* check the function arguments */
+  src = (CNT*)shd +node->sofs;  /* get the shadow counters */
+  dst = (CNT*)node->cnts;       /* and the counters of the node */
+  for (i = node->size; --i >= 0; )
+    dst[i] += src[i];           /* add the shadow counters */
+}  /* _reduce() */              /* to the counters of the node */
+
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#undef KN
+#undef KN__
+#undef KN_
+#undef CNT
+#undef CWD
@@ -57,6 +57,30 @@
             2008.01.25 bug in filtering closed/maximal item sets fixed
             2008.03.13 additional rule evaluation redesigned
             2008.03.24 creation based on ITEMSET structure
+            2026.10.19 counting of path nodes of t.a. trees added
+            2026.10.19 parallel counting with counter shadows added
+            2026.10.19 atomic shared counters and work stealing added
+            2026.10.19 branchless/SIMD search and merge counting added
+            2026.10.19 blocked search index for long id. maps added
+            2026.10.19 level arenas and separate child vectors added
+            2026.10.19 16, 32, and 64 bit counters (per tree) added
+            2026.10.19 support values changed to type SUPP
+            2026.10.19 hash tree counting backend added (IST_HASH)
+            2026.10.19 optimistic levels added (combined passes)
+            2026.10.19 parallel candidate generation added
+            2026.10.19 function ist_fill added (external supports)
+            2026.10.19 triangular array for pair counting added
+            2026.10.19 function ist_pairs added (pairs counted in reading)
+            2026.10.19 hash filter for candidate pairs added (DHP)
+            2026.10.19 function ist_recode added (dense item codes)
+            2026.10.19 ist_set skips sets with two head only items
+            2026.10.19 ist_filter skips sets with two head only items
+            2026.10.19 function ist_setsupp added (rising support)
+            2026.10.19 candidate id. lists added (AprioriTid/Hybrid)
+            2026.10.19 pruning of rule bodies for class assoc. rules
+            2026.10.19 contrast sets of two groups added (ist_cset)
+            2026.10.19 64 bit counters aligned also without ARCH64
+            2026.10.19 minimal counter width (IST_CNT32/IST_CNT64)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -67,6 +91,15 @@
 #include <assert.h>
 #include "istree.h"
 #include "chi2.h"
+#ifndef NOTHREADS
+#include <pthread.h>
+#endif
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__) \
+ && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))) \
+ && !defined NOSIMD             /* if SIMD kernels can be compiled */
+#define SIMD_X86                /* (runtime dispatch is possible) */
+#include <immintrin.h>
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -77,168 +110,640 @@
 #define LN_2       0.69314718055994530942   /* ln(2) */
 #define EPSILON    1e-12        /* to cope with roundoff errors */
 #define BLKSIZE    32           /* block size for level vector */
+#define RECSIZE    1024         /* initial size of record buffer */
+#define PC_BLKSIZE 256          /* transactions per work package */
+#define PC_MAXSHD  (64*1024*1024)  /* max. bytes for counter shadows */
+#define GN_MINNODES 16          /* min. nodes per generation thread */
+#define GN_MINWORK  (1024*1024) /* min. work for parallel generation */
+#define TR_MAXSIZE (256*1024*1024) /* max. bytes for pair counters */
+#define AL_COUNTS  0            /* create a level from the counts, */
+#define AL_OPTIM   1            /* optimistically (without counts), */
+#define AL_PAIRS   2            /* from the frequent pairs or */
+#define AL_ALLPRS  3            /* from all pairs (triangular array) */
+#define AL_MAXGROW 2            /* max. counter growth of opt. level */
+#define LB_LINEAR  16           /* max. size for linear SIMD search */
+#define TD_BLKSIZE 4096         /* block size of candidate id. lists */
+#define MG_RATIO   8            /* max. map/transaction size ratio */
+                                /* for merge-style intersection */
+#define SX_BLKSIZE 16           /* block size of map search index */
+#define SX_SHIFT   4            /* log2(SX_BLKSIZE) */
+#define SX_MINSIZE 64           /* min. map size for a search index */
 #define F_HDONLY   INT_MIN      /* flag for head only item in path */
 #define F_SKIP     INT_MIN      /* flag for subtree skipping */
 #define ID(n)      ((int)((n)->id & ~F_HDONLY))
 #define HDONLY(n)  ((int)((n)->id &  F_HDONLY))
-#define COUNT(n)   ((n) & ~F_SKIP)
+#define F_SSKIP    0x8000       /* skip flag for 16 bit counters */
+#define F_LSKIP    ((LCNT)1 << 63)       /* and for 64 bit counters */
+#define F_CSKIP    (-SUPP_MAX-1)         /* and for support values */
+#define COUNT(n)   ((n) & SUPP_MAX)
+#define ALIGN(n)   (((n) +7) & ~(size_t)7)  /* 8 byte alignment */
+#define CINTS(n,w) (((n)*(w) +sizeof(int)-1) /sizeof(int))
+#define MAP(n,w)   ((n)->cnts +CINTS((n)->size, w))
+#define CNTFN(t)   (_cntfns +((t)->cwd >> 2))
+#define SKIPCNT(n,i,w)     _setcnt(n, i, w, _getcnt(n, i, w) | F_CSKIP)
+#define CLRSKIP(n,i,w)     _setcnt(n, i, w, COUNT(_getcnt(n, i, w)))
+#ifdef NOTHREADS                /* if to count in a single thread */
+#define CNTS(n,s,t)        ((t*)(n)->cnts)
+#define CNTADD(s,c,w)      ((c) += (w))
+#else                           /* if to count in multiple threads */
+#define ATOMIC     ((void*)&_atomic)   /* flag for atomic counting */
+#define CNTS(n,s,t)        ((((s) && ((s) != ATOMIC)) \
+                           ? (t*)(s) +(n)->sofs : (t*)(n)->cnts))
+#define CNTADD(s,c,w)      (((s) == ATOMIC) \
+                           ? (void)ATOMIC_ADD(c, w) : (void)((c) += (w)))
+#if defined __GNUC__ && ((__GNUC__ > 4) \
+                     || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7)))
+#define ATOMIC_ADD(c,w)    __atomic_fetch_add(&(c), w, __ATOMIC_RELAXED)
+#else                           /* use relaxed atomics if possible */
+#define ATOMIC_ADD(c,w)    __sync_fetch_and_add(&(c), w)
+#endif                          /* (counts never reach the sign bit, */
+#endif                          /* so an F_SKIP flag is preserved) */
 
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
-typedef double EVALFN (int set, int body, int head, int n);
+typedef double EVALFN (SUPP set, SUPP body, SUPP head, SUPP n);
 /* function to compute an additional evaluation measure */
 
+typedef unsigned short SCNT;    /* short counter (16 bit) */
+#if defined _MSC_VER            /* long  counter (64 bit) */
+typedef unsigned __int64 LCNT;
+#elif defined __GNUC__
+__extension__ typedef unsigned long long LCNT;
+#else
+typedef unsigned long LCNT;
+#endif
+
+typedef struct {                /* --- counting functions --- */
+  void (*count)  (ISNODE *node, int *set, int cnt, int min, int wgt,
+                  void *shd);   /* count a transaction */
+  void (*countx) (ISNODE *node, TATREE *tat, int min, void *shd);
+                                /* count a transaction tree */
+  void (*cnttri) (void *tri, const size_t *ofs,
+                  const int *set, int beg, int cnt, int wgt);
+#ifndef NOTHREADS               /* count pairs in triangular array */
+  void (*countc) (ISNODE *node, TATREE *tat, int k, int min,
+                  void *shd);   /* count a child of t.a. tree root */
+  void (*reduce) (ISNODE *node, void *shd);
+#endif                          /* add counter shadows to a node */
+} CNTFNS;                       /* (counting functions) */
+
+typedef struct {                /* --- candidate generation data --- */
+  ISTREE *ist;                  /* item set tree to extend */
+  ISNODE *beg, *end;            /* range of deepest nodes to process */
+  SUPP   s_min;                 /* minimal support of an item set */
+  SUPP   s_body;                /* minimal support of a rule body */
+  int    pairs;                 /* whether to keep only freq. pairs */
+  int    *buf;                  /* end of path buffer (supp. checks) */
+  int    *map;                  /* buffer for candidate items */
+  int    *rec;                  /* records of the new nodes */
+  int    rsz, rcnt;             /* size and fill of record buffer */
+  size_t total;                 /* arena size of the new nodes */
+  size_t ccnt, cmax;            /* number of counters of new nodes */
+  int    err;                   /* error flag */
+#ifdef BENCH                    /* if benchmark version */
+  int    sccnt, scnec;          /* (necessary) support counters */
+  int    cpcnt, cpnec;          /* (necessary) child pointers */
+  int    bytes;                 /* number of bytes used */
+#endif
+} GENDATA;                      /* (candidate generation data) */
+
+typedef struct {                /* --- candidate identifier lists --- */
+  ISNODE **nds;                 /* nodes of the lists */
+  int    *ids;                  /* list sizes and counter indices */
+  size_t ncnt, nsz;             /* number of lists, node vector size */
+  size_t icnt, isz;             /* fill and size of the id. vector */
+} TIDLST;                       /* (candidate identifier lists) */
+
+#ifndef NOTHREADS
+typedef struct _pcthrd {        /* --- counting thread --- */
+  struct _parcnt  *pc;          /* shared parallel counting data */
+  int             id;           /* index of the thread */
+  pthread_t       tid;          /* thread identifier */
+  int             run;          /* whether the thread was started */
+  int             beg, end;     /* range of open work packages */
+  pthread_mutex_t lock;         /* lock for the work package range */
+} PCTHREAD;                     /* (counting thread) */
+
+typedef struct _parcnt {        /* --- parallel counting data --- */
+  ISTREE          *ist;         /* item set tree to count in */
+  TATREE          *tat;         /* transaction tree to count or */
+  TASET           *tas;         /* transaction set to count */
+  int             min;          /* level to count (min. t.a. size) */
+  int             cnt;          /* number of work packages */
+  int             thcnt;        /* number of threads */
+  PCTHREAD        *thds;        /* counting threads */
+  CNTFNS          *fns;         /* counting functions */
+  void            **shds;       /* counter shadows of the threads */
+  ISNODE          **bnds;       /* bounds of the reduction ranges */
+} PARCNT;                       /* (parallel counting data) */
+
+static int _atomic;             /* dummy for the flag ATOMIC */
+#endif
+
 /*----------------------------------------------------------------------
   Auxiliary Functions
 ----------------------------------------------------------------------*/
 
+static int _lbscl (const int *vec, int n, int id)
+{                               /* --- lower bound (scalar version) */
+  const int *p = vec;           /* to traverse the vector */
+  int       k;                  /* half of the range size */
+
+  if (n <= 0) return 0;         /* check for an empty vector */
+  while (n > 1) {               /* while the range is not a single */
+    k = n >> 1;                 /* element, halve the range size */
+    p = (p[k] < id) ? p+k : p;  /* (no branch is needed here, */
+    n -= k;                     /* as the compiler can use a */
+  }                             /* conditional move instruction) */
+  return (int)(p -vec) +(*p < id);
+}  /* _lbscl() */               /* return the number of smaller ids */
+
+/*--------------------------------------------------------------------*/
+#ifdef SIMD_X86
+
+__attribute__((target("sse2")))
+static int _lbsse (const int *vec, int n, int id)
+{                               /* --- lower bound (SSE2 version) */
+  const int *p = vec;           /* to traverse the vector */
+  int       i, k;               /* loop variable, half of range size */
+  __m128i   x;                  /* identifier to search for */
+
+  while (n > LB_LINEAR) {       /* narrow the range with branchless */
+    k = n >> 1;                 /* binary search steps */
+    p = (p[k] < id) ? p+k : p;
+    n -= k;                     /* the lower bound is in p[0..n], */
+  }                             /* so the smaller elements of p[0..n-1] */
+  x = _mm_set1_epi32(id);       /* can simply be counted */
+  for (k = (int)(p -vec), i = 0; i+4 <= n; i += 4)
+    k += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(
+           _mm_cmpgt_epi32(x, _mm_loadu_si128((const __m128i*)(p+i))))));
+  for ( ; i < n; i++) k += (p[i] < id);
+  return k;                     /* count the remaining elements */
+}  /* _lbsse() */               /* and return the lower bound */
+
+/*--------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+static int _lbavx (const int *vec, int n, int id)
+{                               /* --- lower bound (AVX2 version) */
+  const int *p = vec;           /* to traverse the vector */
+  int       i, k;               /* loop variable, half of range size */
+  __m256i   x;                  /* identifier to search for */
+
+  while (n > LB_LINEAR) {       /* narrow the range with branchless */
+    k = n >> 1;                 /* binary search steps */
+    p = (p[k] < id) ? p+k : p;
+    n -= k;                     /* the lower bound is in p[0..n], */
+  }                             /* so the smaller elements of p[0..n-1] */
+  x = _mm256_set1_epi32(id);    /* can simply be counted */
+  for (k = (int)(p -vec), i = 0; i+8 <= n; i += 8)
+    k += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(
+           _mm256_cmpgt_epi32(x,
+             _mm256_loadu_si256((const __m256i*)(p+i))))));
+  for ( ; i < n; i++) k += (p[i] < id);
+  return k;                     /* count the remaining elements */
+}  /* _lbavx() */               /* and return the lower bound */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static int (*_lbound) (const int *vec, int n, int id) = _lbscl;
+/* lower bound function: number of elements of a sorted vector */
+/* that are smaller than a given identifier (selected at runtime) */
+
+static void _selsimd (void)
+{                               /* --- select the search functions */
+  #ifdef SIMD_X86               /* if SIMD kernels are available */
+  __builtin_cpu_init();         /* initialize the cpu information */
+  if      (__builtin_cpu_supports("avx2")) _lbound = _lbavx;
+  else if (__builtin_cpu_supports("sse2")) _lbound = _lbsse;
+  else                                     _lbound = _lbscl;
+  #endif                        /* choose the best lower bound */
+}  /* _selsimd() */             /* function the processor supports */
+
+/*--------------------------------------------------------------------*/
+
 static int _bsearch (int *vec, int n, int id)
 {                               /* --- binary search for an item */
-  int i, k;                     /* left and middle index */
+  int k;                        /* index of the lower bound */
 
   assert(vec && (n > 0));       /* check the function arguments */
-  for (i = 0; i < n; ) {        /* while the range is not empty */
-    k = (i + n) >> 1;           /* get index of middle element */
-    if      (vec[k] > id) n = k;
-    else if (vec[k] < id) i = k+1;
-    else return k;              /* adapt range boundaries or return */
-  }                             /* the index the id. was found at */
-  return -1;                    /* return 'not found' */
-}  /* _bsearch() */
+  k = _lbound(vec, n, id);      /* find the lower bound and check */
+  return ((k < n) && (vec[k] == id)) ? k : -1;
+}  /* _bsearch() */             /* whether the identifier was found */
 
+/*----------------------------------------------------------------------
+  Search Index Functions
+----------------------------------------------------------------------*/
+/* Identifier maps of (memory optimized) nodes with at least          */
+/* SX_MINSIZE entries get a search index, which is stored directly    */
+/* behind the map. The index is a static B-tree: the map is split     */
+/* into blocks of SX_BLKSIZE identifiers, the next level contains the */
+/* maximum of each block, and so on, until a level fits into a single */
+/* block.                                                             */
+/* The levels are stored top level first. A search visits one block   */
+/* per level, so that only a few cache lines are touched. The map    */
+/* itself is not reordered, so that counters and children still have */
+/* the same indices as the identifiers.                               */
 /*--------------------------------------------------------------------*/
 
-static void _count (ISNODE *node, int *set, int cnt, int min)
-{                               /* --- count transaction recursively */
-  int    i;                     /* vector index */
-  int    *map, n;               /* identifier map and its size */
-  ISNODE **vec;                 /* child node vector */
+static int _sxsize (int n)
+{                               /* --- get size of a search index */
+  int s = 0;                    /* size of the search index */
 
-  assert(node                   /* check the function arguments */
-      && (cnt >= 0) && (set || (cnt <= 0)));
-  if (node->offset >= 0) {      /* if a pure vector is used */
-    if (node->chcnt == 0) {     /* if this is a new node */
-      n = node->offset;         /* get the index offset */
-      while ((cnt > 0) && (*set < n)) {
-        cnt--; set++; }         /* skip items before first counter */
-      while (--cnt >= 0) {      /* traverse the transaction's items */
-        i = *set++ -n;          /* compute counter vector index */
-        if (i >= node->size) return;
-        node->cnts[i]++;        /* if the counter exists, */
-      } }                       /* count the transaction */
-    else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(node->cnts +node->size);
-      n   = ID(vec[0]);         /* get the child node vector */
-      min--;                    /* one item less to the deepest nodes */
-      while ((cnt > min) && (*set < n)) {
-        cnt--; set++; }         /* skip items before first child */
-      while (--cnt >= min) {    /* traverse the transaction's items */
-        i = *set++ -n;          /* compute child vector index */
-        if (i >= node->chcnt) return;
-        if (vec[i]) _count(vec[i], set, cnt, min);
-      }                         /* if the child exists, */
-    } }                         /* count the transaction recursively */
-  else {                        /* if an identifer map is used */
-    map = node->cnts +(n = node->size);
-    if (node->chcnt == 0) {     /* if this is a new node */
-      while (--cnt >= 0) {      /* traverse the transaction's items */
-        if (*set > map[n-1]) return;  /* if beyond last item, abort */
-        i = _bsearch(map, n, *set++);
-        if (i >= 0) node->cnts[i]++;
-      } }                       /* find index and count transaction */
-    else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(map +n); /* get id. map and child vector */
-      if (node->chcnt < n)      /* if a secondary id. map exists */
-        map = (int*)(vec +(n = node->chcnt));
-      min--;                    /* one item less to the deepest nodes */
-      while (--cnt >= min) {    /* traverse the transaction's items */
-        if (*set > map[n-1]) return;  /* if beyond last item, abort */
-        i = _bsearch(map, n, *set++);
-        if ((i >= 0) && vec[i]) _count(vec[i], set, cnt, min);
-      }                         /* search for the proper index */
-    }                           /* and if the child exists, */
-  }                             /* count the transaction recursively */
-}  /* _count() */
-
-/*--------------------------------------------------------------------*/
-
-static void _countx (ISNODE *node, TATREE *tat, int min)
-{                               /* --- count transa. tree recursively */
-  int    i, k;                  /* vector index, loop variable */
-  int    *map, n;               /* identifier map and its size */
-  ISNODE **vec;                 /* child node vector */
+  while (n > SX_BLKSIZE) {      /* while not a single block */
+    n = (n +SX_BLKSIZE-1) >> SX_SHIFT;
+    s += n;                     /* compute the size of the next level */
+  }                             /* and sum the level sizes */
+  return s;                     /* return the size of the index */
+}  /* _sxsize() */
+
+/*--------------------------------------------------------------------*/
+
+static void _sxbuild (int *map, int n, int *sx)
+{                               /* --- build a search index */
+  int i, j, k;                  /* loop variables */
+  int *src, m;                  /* source level and its size */
+  int *dst;                     /* destination level */
+
+  src = map; m = n;             /* start with the identifier map */
+  dst = sx +_sxsize(n);         /* and at the end of the index */
+  while (m > SX_BLKSIZE) {      /* while not a single block */
+    k    = (m +SX_BLKSIZE-1) >> SX_SHIFT;
+    dst -= k;                   /* get the size of the next level */
+    for (i = 0; i < k; i++) {   /* and traverse its entries */
+      j = ((i+1) << SX_SHIFT) -1;
+      dst[i] = src[(j < m) ? j : m-1];
+    }                           /* note the maximum of each block */
+    src = dst; m = k;           /* go to the next level */
+  }                             /* (levels are stored top-down) */
+}  /* _sxbuild() */
+
+/*--------------------------------------------------------------------*/
+
+static int _sxlbound (int *map, int n, int *sx, int id)
+{                               /* --- lower bound with search index */
+  int d, m[32];                 /* number of levels and their sizes */
+  int i, k;                     /* block index, block size */
+
+  for (m[d = 0] = n; m[d] > SX_BLKSIZE; d++)
+    m[d+1] = (m[d] +SX_BLKSIZE-1) >> SX_SHIFT;
+  if (d <= 0) return _lbound(map, n, id);  /* (no index needed) */
+  i = _lbound(sx, m[d], id);    /* search the top level */
+  if (i >= m[d]) return n;      /* (all identifiers are smaller) */
+  while (--d >= 0) {            /* traverse the remaining levels */
+    sx += m[d+1];               /* go to the next level */
+    if (d == 0) sx = map;       /* (the last level is the map) */
+    i <<= SX_SHIFT;             /* get the start of the block */
+    k = (i +SX_BLKSIZE < m[d]) ? SX_BLKSIZE : m[d] -i;
+    i += _lbound(sx +i, k, id); /* search the block that contains */
+  }                             /* the lower bound of the identifier */
+  return i;                     /* return the lower bound */
+}  /* _sxlbound() */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP _getcnt (ISNODE *node, int i, int w)
+{                               /* --- get a counter of a node */
+  LCNT c;                       /* value of the counter */
+  int  k;                       /* value of a 32 bit counter */
+
+  if (w == 4) {                 /* if 32 bit counters are used */
+    k = node->cnts[i];
+    return (k & F_SKIP) ? (SUPP)(k & ~F_SKIP) | F_CSKIP : (SUPP)k; }
+  if (w == 2) {                 /* if 16 bit counters are used */
+    c = ((SCNT*)node->cnts)[i];
+    return (c & F_SSKIP) ? (SUPP)(c & ~F_SSKIP) | F_CSKIP : (SUPP)c; }
+  c = ((LCNT*)node->cnts)[i];   /* if 64 bit counters are used */
+  return (c & F_LSKIP) ? (SUPP)(c & ~F_LSKIP) | F_CSKIP : (SUPP)c;
+}  /* _getcnt() */              /* (move the skip flag to the */
+                                /* position of the SUPP flag) */
+/*--------------------------------------------------------------------*/
+
+static void _setcnt (ISNODE *node, int i, int w, SUPP c)
+{                               /* --- set a counter of a node */
+  if      (w == 4)              /* if 32 bit counters are used */
+    node->cnts[i] = (c & F_CSKIP)
+                  ? (int)COUNT(c) | F_SKIP : (int)c;
+  else if (w == 2)              /* if 16 bit counters are used */
+    ((SCNT*)node->cnts)[i] = (SCNT)((c & F_CSKIP)
+                           ? COUNT(c) | F_SSKIP : c);
+  else                          /* if 64 bit counters are used */
+    ((LCNT*)node->cnts)[i] = (c & F_CSKIP)
+                           ? (LCNT)COUNT(c) | F_LSKIP : (LCNT)c;
+}  /* _setcnt() */
+
+/*--------------------------------------------------------------------*/
+
+static int _search (ISNODE *node, int *map, int n, int id)
+{                               /* --- search an identifier map */
+  int k;                        /* index of the lower bound */
+
+  if ((node->offset > -2) || (n != node->size))
+    return _bsearch(map, n, id);/* search a map without an index */
+  k = _sxlbound(map, n, map +n, id);
+  return ((k < n) && (map[k] == id)) ? k : -1;
+}  /* _search() */              /* search with the index */
+
+/*--------------------------------------------------------------------*/
+
+#define CNT        SCNT         /* 16 bit counters */
+#define CWD        16
+#include "istcnt.h"
+#define CNT        int          /* 32 bit counters */
+#define CWD        32
+#include "istcnt.h"
+#define CNT        LCNT         /* 64 bit counters */
+#define CWD        64
+#include "istcnt.h"
+
+static CNTFNS _cntfns[3] = {    /* counting functions */
+#ifdef NOTHREADS                /* (indexed with cwd/4) */
+  { _count16, _countx16, _cnttri16 },
+  { _count32, _countx32, _cnttri32 },
+  { _count64, _countx64, _cnttri64 },
+#else
+  { _count16, _countx16, _cnttri16, _countc16, _reduce16 },
+  { _count32, _countx32, _cnttri32, _countc32, _reduce32 },
+  { _count64, _countx64, _cnttri64, _countc64, _reduce64 },
+#endif
+};
+
+#ifndef NOTHREADS
+
+/*--------------------------------------------------------------------*/
+
+static int _getpkg (PARCNT *pc, PCTHREAD *thd)
+{                               /* --- get the next work package */
+  int      i, k, m;             /* loop variable, package indices */
+  PCTHREAD *vic;                /* thread to steal packages from */
+
+  pthread_mutex_lock(&thd->lock);
+  k = (thd->beg < thd->end) ? thd->beg++ : -1;
+  pthread_mutex_unlock(&thd->lock);
+  if (k >= 0) return k;         /* take a package of the own range */
+  for (i = 1; i < pc->thcnt; i++) {
+    vic = pc->thds +(thd->id +i) % pc->thcnt;
+    pthread_mutex_lock(&vic->lock);
+    k = vic->end;               /* traverse the other threads */
+    m = vic->end = k -((k -vic->beg +1) >> 1);
+    pthread_mutex_unlock(&vic->lock);
+    if (m >= k) continue;       /* steal the upper half of the open */
+    pthread_mutex_lock(&thd->lock);    /* packages of a thread */
+    thd->beg = m+1; thd->end = k;
+    pthread_mutex_unlock(&thd->lock);
+    return m;                   /* make the stolen packages the own */
+  }                             /* range and return the first one */
+  return -1;                    /* return 'no package left' */
+}  /* _getpkg() */
+
+/*--------------------------------------------------------------------*/
+
+static void* _cntthrd (void *arg)
+{                               /* --- counting thread function */
+  int      i, k, n;             /* loop variables, work package */
+  int      h;                   /* level to count (min. t.a. size) */
+  void     *shd;                /* counter shadows of the thread */
+  PCTHREAD *thd = (PCTHREAD*)arg;  /* thread data and */
+  PARCNT   *pc  = thd->pc;      /* shared parallel counting data */
+  ISNODE   *root;               /* root of the item set tree */
+
+  root = pc->ist->lvls[0];      /* get the root node, the level */
+  h    = pc->min;               /* and the shadows of this thread */
+  shd  = pc->shds[thd->id];     /* (thread 0 counts in the nodes) */
+  while ((k = _getpkg(pc, thd)) >= 0) {
+    if (pc->tat) {              /* if to count a transaction tree, */
+      pc->fns->countc(root, pc->tat, k, h, shd); continue; }
+    n = (k+1) *PC_BLKSIZE;      /* get the end of the block */
+    if (n > tas_cnt(pc->tas)) n = tas_cnt(pc->tas);
+    for (i = k *PC_BLKSIZE; i < n; i++)
+      if (tas_tsize(pc->tas, i) >= h)
+        pc->fns->count(root, tas_tract(pc->tas, i),
+                       tas_tsize(pc->tas, i), h, 1, shd);
+  }                             /* count the transactions */
+  return NULL;                  /* return a dummy result */
+}  /* _cntthrd() */
+
+/*--------------------------------------------------------------------*/
+
+static void* _redthrd (void *arg)
+{                               /* --- reduction thread function */
+  int      k;                   /* loop variable */
+  PCTHREAD *thd = (PCTHREAD*)arg;  /* thread data and */
+  PARCNT   *pc  = thd->pc;      /* shared parallel counting data */
+  ISNODE   *node;               /* to traverse the nodes */
+
+  for (node = pc->bnds[thd->id]; node != pc->bnds[thd->id+1];
+       node = node->succ)       /* traverse the nodes of the range */
+    for (k = pc->thcnt; --k > 0; )
+      pc->fns->reduce(node, pc->shds[k]);
+  return NULL;                  /* add the shadows to the counters */
+}  /* _redthrd() */
+
+/*--------------------------------------------------------------------*/
+
+static int _parcnt (ISTREE *ist, TATREE *tat, TASET *tas, int min)
+{                               /* --- count transactions in parallel */
+  int      k, n;                /* loop variable, number of threads */
+  int      total, sum;          /* (cumulated) number of counters */
+  char     *blk = NULL;         /* block of counter shadows */
+  ISNODE   *node;               /* to traverse the counted nodes */
+  PARCNT   pc;                  /* shared parallel counting data */
+  PCTHREAD *thds;               /* counting threads */
+
+  assert(ist && (tat || tas)    /* check the function arguments */
+     && (min > 0) && (min <= ist->height));
+  n = (ist->thcnt < 0) ? -ist->thcnt : ist->thcnt;
+  for (total = 0, node = ist->lvls[min-1]; node;
+       node = node->succ) {     /* traverse the nodes to count */
+    node->sofs = total;         /* and note the position */
+    total += node->size;        /* of their counters */
+  }                             /* in the counter shadows */
+  thds    = (PCTHREAD*)malloc(n    *sizeof(PCTHREAD));
+  pc.shds = (void**)   malloc(n    *sizeof(void*));
+  pc.bnds = (ISNODE**) malloc((n+1)*sizeof(ISNODE*));
+  if (!thds || !pc.shds || !pc.bnds) {
+    free(pc.bnds); free(pc.shds); free(thds); return -1; }
+  if ((ist->thcnt > 0)          /* if shadows are not excluded */
+  &&  ((double)(n-1) *total *ist->cwd <= PC_MAXSHD))
+    blk = (char*)calloc((size_t)(n-1) *(size_t)total, ist->cwd);
+  pc.shds[0] = NULL;            /* thread 0 counts in the nodes, */
+  for (k = 1; k < n; k++)       /* all other threads in shadows */
+    pc.shds[k] = (blk) ? blk +(size_t)(k-1) *(size_t)total *ist->cwd
+                       : ATOMIC;
+  pc.ist   = ist; pc.tat = tat; pc.tas = tas; pc.min = min;
+  pc.fns   = CNTFN(ist);        /* get the counting functions */
+  pc.cnt   = (tat) ? tat_size(tat)
+           : (tas_cnt(tas) +PC_BLKSIZE-1) /PC_BLKSIZE;
+  pc.thcnt = n;                 /* note the number of threads */
+  pc.thds  = thds;              /* and the thread data */
+  for (k = 0; k < n; k++) {     /* initialize the thread data */
+    thds[k].pc  = &pc; thds[k].id  = k; thds[k].run = 0;
+    thds[k].beg = (int)(((double)pc.cnt * k)    /n);
+    thds[k].end = (int)(((double)pc.cnt *(k+1)) /n);
+    pthread_mutex_init(&thds[k].lock, NULL);
+  }                             /* distribute the work packages */
+  if (!blk) pc.shds[0] = ATOMIC;/* without shadows count atomically */
+
+  /* --- count transactions --- */
+  for (k = 1; k < n; k++)       /* start the counting threads */
+    thds[k].run = (pthread_create(&thds[k].tid, NULL,
+                                  _cntthrd, thds+k) == 0);
+  _cntthrd(thds);               /* count in the calling thread, */
+  for (k = 1; k < n; k++)       /* then wait for the other threads */
+    if (thds[k].run) pthread_join(thds[k].tid, NULL);
+  for (k = 0; k < n; k++)       /* (packages of threads that failed */
+    pthread_mutex_destroy(&thds[k].lock);     /* have been stolen) */
+
+  /* --- reduce counter shadows --- */
+  if (blk) {                    /* if counter shadows were used */
+    pc.bnds[0] = node = ist->lvls[min-1];
+    for (sum = 0, k = 1; k < n; k++) {
+      while (node && ((double)sum *n < (double)k *total)) {
+        sum += node->size; node = node->succ; }
+      pc.bnds[k] = node;        /* split the counted nodes into */
+    }                           /* ranges with about the same */
+    pc.bnds[n] = NULL;          /* number of counters */
+    for (k = 1; k < n; k++)     /* start the reduction threads */
+      thds[k].run = (pthread_create(&thds[k].tid, NULL,
+                                    _redthrd, thds+k) == 0);
+    _redthrd(thds);             /* reduce in the calling thread */
+    for (k = 1; k < n; k++) {   /* and wait for the other threads */
+      if (thds[k].run) pthread_join(thds[k].tid, NULL);
+      else             _redthrd(thds+k);
+    }                           /* (reduce ranges of failed threads) */
+  }
+  free(blk); free(pc.bnds); free(pc.shds); free(thds);
+  return 0;                     /* clean up and return 'ok' */
+}  /* _parcnt() */
+
+#endif
 
-  assert(node && tat);          /* check the function arguments */
-  if (tat_max(tat) < min)       /* if the transactions are too short, */
+/*--------------------------------------------------------------------*/
+
+static void _htadd (ISTREE *ist, int n, int wgt)
+{                               /* --- add weight to hit counters */
+  void **hits;                  /* counters of contained candidates */
+
+  assert(ist && ist->htree && (n >= 0));  /* check the arguments */
+  hits = ht_hits(ist->htree);   /* get the hits of the last match */
+  if      (ist->cwd == 2)       /* if 16 bit counters are used */
+    while (--n >= 0) *(SCNT*)hits[n] += (SCNT)wgt;
+  else if (ist->cwd == 4)       /* if 32 bit counters are used */
+    while (--n >= 0) *(int*) hits[n] += wgt;
+  else                          /* if 64 bit counters are used */
+    while (--n >= 0) *(LCNT*)hits[n] += (LCNT)wgt;
+}  /* _htadd() */
+
+/*--------------------------------------------------------------------*/
+
+static void _htcountx (ISTREE *ist, TATREE *tat, int len)
+{                               /* --- count a t.a. tree (hash tree) */
+  int    i, k;                  /* loop variable, node size */
+  int    wgt;                   /* number of t.a. ending at the node */
+  int    *buf;                  /* buffer for the current t.a. */
+  TATREE *child;                /* child of the t.a. tree node */
+
+  assert(ist && ist->htree && tat && (len >= 0));
+  if (len +tat_max(tat) < ht_size(ist->htree))
+    return;                     /* skip too short transactions */
+  buf = ht_buf(ist->htree);     /* get the transaction buffer */
+  wgt = tat_cnt(tat);           /* and the number of transactions */
+  k   = tat_size(tat);          /* get the number of children */
+  if (k < 0) {                  /* if the node is a path node, */
+    memcpy(buf +len, tat_items(tat), (size_t)-k *sizeof(int));
+    len  -= k;                  /* append the items of the path */
+    child = tat_tail(tat);      /* if some transactions are longer, */
+    if (child) {                /* count the rest of them */
+      wgt -= tat_cnt(child); _htcountx(ist, child, len); } }
+  else {                        /* if the node is a normal node */
+    for (i = 0; i < k; i++) {   /* traverse the children */
+      child    = tat_child(tat, i);
+      wgt     -= tat_cnt(child);/* (the other transactions end here) */
+      buf[len] = tat_item(tat, i);
+      _htcountx(ist, child, len+1);
+    }                           /* append the item of the child */
+  }                             /* and count its subtree */
+  if (wgt > 0)                  /* count the ending transactions */
+    _htadd(ist, ht_match(ist->htree, buf, len), wgt);
+}  /* _htcountx() */
+
+/*--------------------------------------------------------------------*/
+
+static void _tricountx (ISTREE *ist, TATREE *tat, int *buf, int len)
+{                               /* --- count a t.a. tree (pairs) */
+  int    i, k;                  /* loop variable, node size */
+  TATREE *child;                /* child of the transaction tree node */
+
+  assert(ist && ist->tri && tat && buf && (len >= 0));
+  if (len +tat_max(tat) < 2)    /* if the transactions are too short, */
     return;                     /* abort the recursion */
   k = tat_size(tat);            /* get the number of children */
-  if (k <= 0) {                 /* if there are no children */
-    if (k < 0) _count(node, tat_items(tat), -k, min);
-    return;                     /* count the normal transaction */
-  }                             /* and abort the function */
-  while (--k >= 0)              /* count the transactions recursively */
-    _countx(node, tat_child(tat, k), min);
-  if (node->offset >= 0) {      /* if a pure vector is used */
-    if (node->chcnt == 0) {     /* if this is a new node */
-      n = node->offset;         /* get the index offset */
-      for (k = tat_size(tat); --k >= 0; ) {
-        i = tat_item(tat,k) -n; /* traverse the items */
-        if (i < 0) return;      /* if before first item, abort */
-        if (i < node->size)     /* if inside the counter range */
-          node->cnts[i] += tat_cnt(tat_child(tat, k));
-      } }                       /* count the transaction */
-    else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(node->cnts +node->size);
-      n   = ID(vec[0]);         /* get the child node vector */
-      min--;                    /* one item less to the deepest nodes */
-      for (k = tat_size(tat); --k >= 0; ) {
-        i = tat_item(tat,k) -n; /* traverse the items */
-        if (i < 0) return;      /* if before first item, abort */
-        if ((i < node->chcnt) && vec[i])
-          _countx(vec[i], tat_child(tat, k), min);
-      }                         /* if the child exists, */
-    } }                         /* count the transaction recursively */
-  else {                        /* if an identifer map is used */
-    map = node->cnts +(n = node->size);
-    if (node->chcnt == 0) {     /* if this is a new node */
-      for (k = tat_size(tat); --k >= 0; ) {
-        i = tat_item(tat, k);   /* get the next item */
-        if (i < map[0]) return; /* if before first item, abort */
-        i = _bsearch(map, n, i);
-        if (i >= 0) node->cnts[i] += tat_cnt(tat_child(tat, k));
-      } }                       /* find index and count transaction */
-    else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(map +n); /* get id. map and child vector */
-      if (node->chcnt < n)      /* if a secondary id. map exists */
-        map = (int*)(vec +(n = node->chcnt));
-      min--;                    /* one item less to the deepest nodes */
-      for (k = tat_size(tat); --k >= 0; ) {
-        i = tat_item(tat, k);   /* get the next item */
-        if (i < map[0]) return; /* if before first item, abort */
-        i = _bsearch(map, n, i);
-        if ((i >= 0) && vec[i]) _countx(vec[i], tat_child(tat, k), min);
-      }                         /* search for the proper index */
-    }                           /* and if the child exists, */
-  }                             /* count the transaction recursively */
-}  /* _countx() */
-
-/*--------------------------------------------------------------------*/
-
-static int _checksub (ISNODE *node)
+  if (k < 0) {                  /* if the node is a path node */
+    memcpy(buf +len, tat_items(tat), (size_t)-k *sizeof(int));
+    CNTFN(ist)->cnttri(ist->tri, ist->tofs, buf, len, len-k,
+                       tat_cnt(tat));  /* count the pairs that end */
+    child = tat_tail(tat);      /* with an item of the path */
+    if (child) _tricountx(ist, child, buf, len-k);
+    return;                     /* count the transactions that */
+  }                             /* are longer than the path */
+  for (i = 0; i < k; i++) {     /* traverse the children */
+    child    = tat_child(tat, i);
+    buf[len] = tat_item(tat, i);/* append the item of the child */
+    if (len > 0)                /* and count the pairs it ends */
+      CNTFN(ist)->cnttri(ist->tri, ist->tofs, buf, len, len+1,
+                         tat_cnt(child));
+    _tricountx(ist, child, buf, len+1);
+  }                             /* count the subtree of the child */
+}  /* _tricountx() */
+
+/*--------------------------------------------------------------------*/
+
+static int _htbuild (ISTREE *ist)
+{                               /* --- build hash tree for new level */
+  int    i, k, n;               /* loop variables, number of items */
+  int    item;                  /* item of a candidate */
+  int    *set;                  /* items of a candidate */
+  ISNODE *node, *p;             /* to traverse the nodes */
+  char   *cnts;                 /* counter vector of a node */
+
+  assert(ist && !ist->htree);   /* check the function argument */
+  n = is_cnt(ist->set);         /* create a hash tree for item sets */
+  ist->htree = ht_create(ist->height, n);   /* of the deepest level */
+  if (!ist->htree) return -1;
+  set = ist->buf;               /* get the candidate buffer */
+  for (node = ist->lvls[ist->height-1]; node; node = node->succ) {
+    k = ist->height -1;         /* traverse the deepest nodes */
+    for (p = node; p->parent; p = p->parent)
+      set[--k] = ID(p);         /* collect the path to the node */
+    cnts = (char*)node->cnts;   /* get the counter vector */
+    for (i = 0; i < node->size; i++) {
+      item = (node->offset >= 0) ? node->offset +i
+                                 : MAP(node, ist->cwd)[i];
+      if (item >= n) break;     /* skip padding counters */
+      set[ist->height-1] = item;/* add the candidate with its counter */
+      if (ht_add(ist->htree, set, cnts +i *ist->cwd) < 0)
+        return -1;              /* (the counters of the deepest level */
+    }                           /* are incremented via the hash tree) */
+  }
+  return 0;                     /* return 'ok' */
+}  /* _htbuild() */
+
+/*--------------------------------------------------------------------*/
+
+static int _checksub (ISNODE *node, int lvl)
 {                               /* --- recursively check subtrees */
   int    i, r;                  /* vector index, result */
   ISNODE **vec;                 /* child node vector */
 
   assert(node);                 /* check the function argument */
+  if (lvl          <= 0) return  0;  /* do not skip uncounted levels */
   if (node->chcnt  == 0) return  0;  /* do not skip new leaves */
   if (node->chcnt  <  0) return -1;  /* skip marked subtrees */
-  if (node->offset >= 0)        /* if a pure vector is used */
-    vec = (ISNODE**)(node->cnts +node->size);
-  else                          /* if an identifer map is used */
-    vec = (ISNODE**)(node->cnts +node->size +node->size);
+  vec = node->chvec;            /* get the child vector */
   for (r = -1, i = node->chcnt; --i >= 0; )
-    if (vec[i]) r &= _checksub(vec[i]);
+    if (vec[i]) r &= _checksub(vec[i], lvl-1);
   if (!r) return 0;             /* recursively check all children */
   node->chcnt |= F_SKIP;        /* set the skip flag if possible */
   return -1;                    /* return 'subtree can be skipped' */
@@ -246,7 +751,7 @@ static int _checksub (ISNODE *node)
 
 /*--------------------------------------------------------------------*/
 
-static int _checkuse (ISNODE *node, char *marks, int supp)
+static int _checkuse (ISNODE *node, char *marks, SUPP supp, int w)
 {                               /* --- recursively check item usage */
   int    i, r = 0;              /* vector index, result of check */
   int    *map, n;               /* identifier map and its size */
@@ -257,25 +762,25 @@ static int _checkuse (ISNODE *node, char *marks, int supp)
     if (node->chcnt == 0) {     /* if this is a new node */
       n = node->offset;         /* get the index offset */
       for (i = node->size; --i >= 0; ) {
-        if (node->cnts[i] >= supp)
+        if (_getcnt(node, i, w) >= supp)
           marks[n+i] = r = 1;   /* mark items in set that satisfies */
       } }                       /* the minimum support criterion */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(node->cnts +node->size);
+      vec = node->chvec;
       for (i = node->chcnt; --i >= 0; )
-        if (vec[i]) r |= _checkuse(vec[i], marks, supp);
+        if (vec[i]) r |= _checkuse(vec[i], marks, supp, w);
     } }                         /* recursively process all children */
   else {                        /* if an identifer map is used */
-    map = node->cnts +node->size;
+    map = MAP(node, w);
     if (node->chcnt == 0) {     /* if this is a new node */
       for (i = node->size; --i >= 0; ) {
-        if (node->cnts[i] >= supp)
+        if (_getcnt(node, i, w) >= supp)
           marks[map[i]] = r = 1;/* mark items in set that satisfies */
       } }                       /* the minimum support criterion */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      vec = (ISNODE**)(map +node->size);
+      vec = node->chvec;
       for (i = node->chcnt; --i >= 0; )
-        if (vec[i]) r |= _checkuse(vec[i], marks, supp);
+        if (vec[i]) r |= _checkuse(vec[i], marks, supp, w);
     }                           /* get the child vector and */
   }                             /* recursively process all children */
   if ((r != 0) && node->parent) /* if the check succeeded, mark */
@@ -285,7 +790,7 @@ static int _checkuse (ISNODE *node, char *marks, int supp)
 
 /*--------------------------------------------------------------------*/
 
-static int _getsupp (ISNODE *node, int *set, int cnt)
+static SUPP _getsupp (ISNODE *node, int *set, int cnt, int w)
 {                               /* --- get support of an item set */
   int    i, n, c;               /* vector index, buffers */
   int    *map;                  /* identifier map */
@@ -296,15 +801,15 @@ static int _getsupp (ISNODE *node, int *set, int cnt)
     c = node->chcnt & ~F_SKIP;  /* if there are no children, */
     if (c <= 0) return -1;      /* the support is less than minsupp */
     if (node->offset >= 0) {    /* if a pure vector is used */
-      vec = (ISNODE**)(node->cnts +node->size);
+      vec = node->chvec;
       i   = *set++ -ID(vec[0]); /* compute the child vector index and */
       if (i >= c) return -1; }  /* abort if the child does not exist */
     else {                      /* if an identifier map is used */
-      map = node->cnts +(n = node->size);
-      vec = (ISNODE**)(map +n); /* get id. map and child vector */
+      map = MAP(node, w); n = node->size;
+      vec = node->chvec;        /* get the child vector */
       if (c < n)                /* if a secondary id. map exists, */
         map = (int*)(vec +(n = c));    /* get this identifier map */
-      i = _bsearch(map, n, *set++);
+      i = _search(node, map, n, *set++);
     }                           /* search for the proper index */
     if (i < 0) return -1;       /* abort if index is out of range */
     node = vec[i];              /* go to the corresponding child */
@@ -314,16 +819,17 @@ static int _getsupp (ISNODE *node, int *set, int cnt)
     i = *set -node->offset;     /* compute the counter index */
     if (i >= node->size) return -1; }
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    i   = _bsearch(map, n, *set);
+    map = MAP(node, w); n = node->size;
+    i   = _search(node, map, n, *set);
   }                             /* search for the proper index */
   if (i < 0) return -1;         /* abort if index is out of range */
-  return node->cnts[i];         /* return the item set support */
+  return _getcnt(node, i, w);   /* return the item set support */
 }  /* _getsupp() */
 
 /*--------------------------------------------------------------------*/
 
-static void _marksupp (ISNODE *node, int *set, int cnt, int supp)
+static void _marksupp (ISNODE *node, int *set, int cnt, SUPP supp,
+                       int w)
 {                               /* --- mark support of an item set */
   int    i, n, c;               /* vector index, buffers */
   int    *map;                  /* identifier map */
@@ -332,53 +838,126 @@ static void _marksupp (ISNODE *node, int *set, int cnt, int supp)
   assert(node && set && (cnt >= 0)); /* check the function arguments */
   while (--cnt > 0) {           /* follow the set/path from the node */
     if (node->offset >= 0) {    /* if a pure vector is used */
-      vec = (ISNODE**)(node->cnts +node->size);
+      vec = node->chvec;
       i   = *set++ -ID(vec[0]);}/* compute the child vector index */
     else {                      /* if an identifier map is used */
-      map = node->cnts +(n = node->size);
-      vec = (ISNODE**)(map +n); /* get id. map, child vector and */
+      map = MAP(node, w); n = node->size;
+      vec = node->chvec;        /* get the child vector and */
       c   = node->chcnt & ~F_SKIP;     /* the number of children */
       if (c < n)                /* if a secondary id. map exists, */
         map = (int*)(vec +(n = c));    /* get this identifier map */
-      i = _bsearch(map, n, *set++);
+      i = _search(node, map, n, *set++);
     }                           /* search for the proper index */
     node = vec[i];              /* go to the corresponding child */
   }
   if (node->offset >= 0)        /* if a pure vector is used, */
     i = *set -node->offset;     /* compute the counter index */
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    i   = _bsearch(map, n, *set);
+    map = MAP(node, w); n = node->size;
+    i   = _search(node, map, n, *set);
   }                             /* search for the proper index */
   if ((supp < 0)                /* if to clear unconditionally */
-  ||  (node->cnts[i] == supp))  /* or the support is the same */
-    node->cnts[i] |= F_SKIP;    /* mark support as cleared */
+  ||  (_getcnt(node, i, w) == supp))     /* or the support is same */
+    SKIPCNT(node, i, w);        /* mark support as cleared */
 }  /* _marksupp() */
 
 /*--------------------------------------------------------------------*/
 
-static void _marksub (ISTREE *ist, ISNODE *node, int index, int supp)
+static void _marksub (ISTREE *ist, ISNODE *node, int index, SUPP supp)
 {                               /* --- mark all n-1 subsets */
   int i;                        /* next item, loop variable */
   int *set;                     /* (partial) item set */
 
   if (node->offset >= 0) i = node->offset +index;
-  else                   i = node->cnts[node->size +index];
+  else                   i = MAP(node, ist->cwd)[index];
   set = ist->buf +ist->vsz;     /* get and store the first two items */
-  *--set = i;        _marksupp(node->parent, set, 1, supp);
-  *--set = ID(node); _marksupp(node->parent, set, 1, supp);
+  *--set = i;        _marksupp(node->parent, set, 1, supp, ist->cwd);
+  *--set = ID(node); _marksupp(node->parent, set, 1, supp, ist->cwd);
   i = 2;                        /* mark counters in parent node */
   for (node = node->parent; node->parent; node = node->parent) {
-    _marksupp(node->parent, set, i, supp);
+    _marksupp(node->parent, set, i, supp, ist->cwd);
     *--set = ID(node); i++;     /* climb up the tree and mark */
   }                             /* counters for all n-1 subsets */
 }  /* _marksub() */
 
+/*----------------------------------------------------------------------
+  For class association rules (IST_CARS) the head only items are the
+classes. They are coded last (see apriori.c), so that each node of a
+body set ends with one counter per class, which counts the body set
+together with the class. Since a rule B -> c needs supp(B u {c}) >=
+s_min and this support can only shrink if B is extended, a body set is
+extended by a candidate item only if for some candidate class all
+subsets of the path items, the candidate item and the class that are
+already counted have enough support. In particular, a body set without
+a class candidate gets no child node at all.
+  For contrast sets (IST_CONTR) the two classes are group labels and
+the counters of both labels are kept in every node of a body set, so
+that both group supports of each body set are known exactly. A body
+set is extended only if it may still reach the minimal support in one
+group and, for the chi^2 measure, if the largest chi^2 value that any
+superset may have, which is attained at a corner of the box spanned by
+the group support bounds (the measure is convex), reaches the minimum.
+----------------------------------------------------------------------*/
+
+static double _cbound (ISTREE *ist, SUPP u1, SUPP u2);
+
+/*--------------------------------------------------------------------*/
+
+static SUPP _clsbnd (ISTREE *ist, ISNODE *node, int item, int cls,
+                     SUPP s_min, int *buf)
+{                               /* --- bound support with a class */
+  int    cnt, *set;             /* (partial) item set to check */
+  SUPP   s, u;                  /* support of a subset, upper bound */
+  ISNODE *curr;                 /* to traverse the path to the root */
+
+  set = buf -1; *set = cls;     /* get the support of the node's */
+  u   = _getsupp(node, set, 1, ist->cwd); /* set with the class */
+  set = buf -(cnt = 2);         /* init. the set for support checks */
+  if (item < cls) { set[0] = item; set[1] = cls;  }
+  else            { set[0] = cls;  set[1] = item; }
+  for (curr = node; curr->parent && (u >= s_min); curr = curr->parent) {
+    s = _getsupp(curr->parent, set, cnt, ist->cwd);
+    if (s < u) u = s;           /* check the subsets that contain */
+    *--set = ID(curr); cnt++;   /* the item and the class (as for */
+  }                             /* a candidate of the child node) */
+  return (u < 0) ? s_min -1 : u;/* a missing or skipped subset is */
+}  /* _clsbnd() */              /* infrequent (below s_min) */
+
 /*--------------------------------------------------------------------*/
 
-static ISNODE* _child (ISTREE *ist, ISNODE *node, int index,
-                       int s_min, int s_body)
-{                               /* --- create child node (extend set) */
+static int _cars (ISTREE *ist, ISNODE *node, SUPP s_min,
+                  int *buf, int *map, int n)
+{                               /* --- prune body candidates (CARs) */
+  int    i, k, c, h, m, r;      /* loop variables, candidate items */
+  SUPP   u, ub[2];              /* upper bounds of group supports */
+
+  assert(ist && node && buf && map);  /* check the function arguments */
+  for (h = n; (h > 0) && (is_getapp(ist->set, map[h-1]) == IST_HEAD); )
+    h--;                        /* find the classes (coded last) */
+  for (m = i = 0; i < n; i++) { /* traverse the candidate items */
+    k = map[i];                 /* keep the classes (head only items) */
+    if (is_getapp(ist->set, k) == IST_HEAD) { map[m++] = k; continue; }
+    ub[0] = ub[1] = 0;          /* clear the group support bounds */
+    for (r = 0, c = n; --c >= h; ) {
+      u = _clsbnd(ist, node, k, map[c], s_min, buf);
+      ub[(map[c] == ist->grps[0]) ? 0 : 1] = u;
+      if (u < s_min) continue;  /* traverse the class candidates */
+      r = 1;                    /* and check whether a rule with the */
+      if (!(ist->mode & IST_CONTR)) break;   /* class (or a contrast */
+    }                           /* set of its group) may be found */
+    if (r && (ist->mode & IST_CONTR)  /* for contrast sets check */
+    &&  ((ist->arem == EM_CHI2) || (ist->arem == EM_PVAL)))
+      r = (_cbound(ist, ub[0], ub[1]) >= ist->minval);
+    if (r) map[m++] = k;        /* whether the measure may still */
+  }                             /* be reached, keep the candidate */
+  return m;                     /* return the number of candidates */
+}  /* _cars() */
+
+/*--------------------------------------------------------------------*/
+
+static int _child (ISTREE *ist, ISNODE *node, int index,
+                   SUPP s_min, SUPP s_body, int *buf, int *map, int *id)
+{                               /* --- check for a child (extend set) */
   int    i, k, n;               /* loop variables, counters */
   ISNODE *curr;                 /* to traverse the path to the root */
   int    item, cnt;             /* item identifier, number of items */
@@ -386,43 +965,48 @@ static ISNODE* _child (ISTREE *ist, ISNODE *node, int index,
   int    body;                  /* enough support for a rule body */
   int    hdonly;                /* whether head only item on path */
   int    app;                   /* appearance flags of an item */
-  int    s_set;                 /* support of an item set */
+  SUPP   s_set;                 /* support of an item set */
 
   assert(ist && node            /* check the function arguments */
      && (index >= 0) && (index < node->size));
   if (node->offset >= 0) item = node->offset +index;
-  else                   item = node->cnts[node->size +index];
+  else                   item = MAP(node, ist->cwd)[index];
   app = is_getapp(ist->set, item);   /* get item id. and app. flag */
   if ((app == IST_IGNORE)       /* do not extend an item to ignore */
   ||  ((HDONLY(node) && (app == IST_HEAD))))
-    return NULL;                /* nor a set with two head only items */
+    return 0;                   /* nor a set with two head only items */
   hdonly = HDONLY(node) || (app == IST_HEAD);
 
   /* --- initialize --- */
-  s_set = node->cnts[index];    /* get support of item set to extend */
-  if (s_set < s_min)            /* if set support is insufficient, */
-    return NULL;                /* no child is needed, so abort */
+  s_set = _getcnt(node, index, ist->cwd);
+  if (s_set < s_min)            /* get support of item set to extend */
+    return 0;                   /* and if it is insufficient, abort */
   body = (s_set >= s_body)      /* if the set has enough support for */
        ? 1 : 0;                 /* a rule body, set the body flag */
-  ist->buf[ist->vsz -2] = item; /* init. set for support checks */
+  buf[-2] = item;               /* init. set for support checks */
 
   /* --- check candidates --- */
   for (n = 0, i = index; ++i < node->size; ) {
     if (node->offset >= 0) k = node->offset +i;
-    else                   k = node->cnts[node->size +i];
+    else                   k = MAP(node, ist->cwd)[i];
     app = is_getapp(ist->set, k);  /* traverse the candidate items */
     if ((app == IST_IGNORE) || (hdonly && (app == IST_HEAD)))
       continue;                 /* skip sets with two head only items */
-    s_set = node->cnts[i];      /* traverse the candidate items */
+    if ((app == IST_HEAD) && (ist->mode & IST_CONTR)) {
+      map[n++] = k; continue; } /* always count the group labels */
+    s_set = _getcnt(node, i, ist->cwd); /* get candidate support */
     if (s_set <  s_min)         /* if set support is insufficient, */
       continue;                 /* ignore the corresponding candidate */
+    if (!node->parent && ist->set->bkts
+    &&  (is_getbfq(ist->set, item, k) < s_min))
+      continue;                 /* skip pairs in infrequent buckets */
     body &= 1;                  /* restrict body flags to the set S */
     if (s_set >= s_body)        /* if set support is sufficient for */
       body |= 2;                /* a rule body, set the body flag */ 
-    set    = ist->buf +ist->vsz -(cnt = 2);
+    set    = buf -(cnt = 2);
     set[1] = k;                 /* add the candidate item to the set */
     for (curr = node; curr->parent; curr = curr->parent) {
-      s_set = _getsupp(curr->parent, set, cnt);
+      s_set = _getsupp(curr->parent, set, cnt, ist->cwd);
       if (s_set <  s_min)       /* get the item set support and */
         break;                  /* if it is too low, abort the loop */
       if (s_set >= s_body)      /* if some subset has enough support */
@@ -430,49 +1014,93 @@ static ISNODE* _child (ISTREE *ist, ISNODE *node, int index,
       *--set = ID(curr); cnt++; /* add id of current node to the set */
     }                           /* and adapt the number of items */
     if (!curr->parent && body)  /* if subset support is high enough */
-      ist->map[n++] = k;        /* for a full rule and a rule body, */
+      map[n++] = k;             /* for a full rule and a rule body, */
   }                             /* note the item identifier */
-  if (n <= 0) return NULL;      /* if no child is needed, abort */
-  #ifdef BENCH                  /* if benchmark version: */
-  ist->scnec += n;              /* sum the necessary counters */
-  #endif
+  if ((ist->mode & IST_CARS) && !hdonly)
+    n = _cars(ist, node, s_min, buf, map, n);
+  if (n <= 0) return 0;         /* if no child is needed, abort */
+  *id = (hdonly) ? item | F_HDONLY : item;
+  return n;                     /* return the item identifier */
+}  /* _child() */                /* and the number of candidates */
 
-  /* --- decide on node structure --- */
-  k = ist->map[n-1] -ist->map[0] +1;
-  if (!(ist->mode & IST_MEMOPT)) n = k;
-  else if (3*n >= 2*k) n = k;   /* use a pure vector if it is small */
-  else                 k = n+n; /* enough, otherwise use an id. map */
-  #ifdef ARCH64                 /* if 64 bit architecture */
-  if ((n == k) && (k & 1)) n = ++k;
-  #endif                        /* pad to even number of counters */
-  #ifdef BENCH                  /* if benchmark version */
-  ist->sccnt += n;              /* sum the number of counters */
-  ist->bytes += sizeof(ISNODE) +(k-1) *sizeof(int) +8;
-  #endif                        /* determine the memory usage */
-
-  /* --- create child --- */
-  curr = (ISNODE*)malloc(sizeof(ISNODE) +(k-1) *sizeof(int));
-  if (!curr) return (void*)-1;  /* create a child node */
-  curr->parent = node;          /* set pointer to parent node */
-  curr->succ   = NULL;          /* and clear successor pointer */
-  curr->id     = item;          /* initialize the item id. and */
-  if (hdonly) curr->id |= F_HDONLY;  /* set the head only flag */
-  curr->chcnt  = 0;             /* there are no children yet */
-  curr->size   = n;             /* set size of counter vector */
-  if (n == k)                   /* if to use a pure vector, */
-    curr->offset = ist->map[0]; /* note the first item as an offset */
-  else {                        /* if to use an identifier map, */
-    curr->offset = -1;          /* use the offset as an indicator */
-    for (set = curr->cnts +n +(i = n); --i >= 0; )
-      *--set = ist->map[i];     /* copy the identifier map */
-  }                             /* from the buffer to the node */
-  for (set = curr->cnts +(i = n); --i >= 0; )
-    *--set = 0;                 /* clear all counters of the node */
-  return curr;                  /* return pointer to created child */
-}  /* _child() */
+/*----------------------------------------------------------------------
+  Several levels may be counted in one pass through the transactions
+(combined passes). The first of these levels is created as usual from
+the counted deepest level, all further levels are created optimistic-
+ally from the uncounted level above them (ist_addopt). In order to do
+this, the counters of an uncounted level that do not belong to actual
+candidates (gaps in pure counter vectors) are marked with the skip
+flag, so that a candidate of an optimistic level is created only if
+all of its subsets are candidates. After the pass, the candidates of
+the optimistic levels that would not have been created from the new
+counts are marked with the skip flag as well (_prune), so that the
+tree contains the same valid item sets as with one level per pass.
+----------------------------------------------------------------------*/
+
+static void _flag (ISTREE *ist, int lvl, SUPP s_min, SUPP s_body)
+{                               /* --- flag non-candidate counters */
+  int    i, k, n;               /* loop variables, number of cands. */
+  int    id, item;              /* item identifiers */
+  int    *map;                  /* identifier map of a node */
+  ISNODE *node, *par;           /* to traverse the nodes, parent */
+
+  assert(ist && (lvl > 0) && (lvl < ist->height));
+  for (node = ist->lvls[lvl]; node; node = node->succ) {
+    par = node->parent;         /* traverse the nodes of the level */
+    if (par->offset >= 0) i = ID(node) -par->offset;
+    else i = _search(par, MAP(par, ist->cwd), par->size, ID(node));
+    n = _child(ist, par, i, s_min, s_body,
+               ist->buf +ist->vsz, ist->map, &id);
+    map = (node->offset < 0) ? MAP(node, ist->cwd) : NULL;
+    for (k = i = 0; i < node->size; i++) {
+      item = (map) ? map[i] : node->offset +i;
+      while ((k < n) && (ist->map[k] < item)) k++;
+      if ((k >= n) || (ist->map[k] != item))
+        SKIPCNT(node, i, ist->cwd);
+    }                           /* mark all counters that do not */
+  }                             /* belong to a candidate item set */
+}  /* _flag() */
+
+/*--------------------------------------------------------------------*/
+
+static void _prune (ISTREE *ist)
+{                               /* --- prune the optimistic levels */
+  int k;                        /* loop variable */
+
+  assert(ist);                  /* check the function argument */
+  for (k = ist->height -ist->ucnt +1; k < ist->height; k++)
+    _flag(ist, k, ist->supp, ist->rule);
+  ist->ucnt = 1;                /* mark non-candidates in all levels */
+}  /* _prune() */                /* that were created optimistically */
+
+/*--------------------------------------------------------------------*/
+
+static int _layout (ISTREE *ist, int *map, int n, int *size)
+{                               /* --- decide on node structure */
+  int k;                        /* size of the item range */
+
+  assert(ist && map && (n > 0) && size);  /* check the arguments */
+  k = map[n-1] -map[0] +1;
+  if (!(ist->mode & IST_MEMOPT) || (3*n >= 2*k)) {
+    #ifdef ARCH64               /* if 64 bit architecture */
+    k += k & 1;                 /* pad to even number of counters */
+    #endif                      /* use a pure vector if it is small */
+    *size = k;                  /* enough, that is, set the size and */
+    return CINTS(k, ist->cwd);  /* return the number of integers */
+  }                             /* for the counters only */
+  *size = n;                    /* otherwise use an identifier map */
+  k = CINTS(n, ist->cwd) +n;    /* (with a search index if it is */
+  if (n >= SX_MINSIZE) k += _sxsize(n);  /* long enough) */
+  return k;                     /* return the number of integers */
+}  /* _layout() */
 
 /*----------------------------------------------------------------------
-  In the above function the set S represented by the index-th vector
+  The function _child only checks whether a child node is needed for
+the set S represented by the index-th vector element of the current
+node; the candidate items are collected in the identifier map buffer
+of the tree and the node itself is created in ist_addlvl, where all
+nodes of a new level are placed into a single memory block.
+  In the function _child the set S represented by the index-th vector
 element of the current node is extended only by combining it with the
 sets represented by the fields that follow it in the node vector,
 i.e. by the sets represented by vec[index+1] to vec[size-1]. The sets
@@ -511,35 +1139,23 @@ items is determined from the nodes 'hdonly' flag and the appearance
 flags of the items.
 ----------------------------------------------------------------------*/
 
-static void _cleanup (ISTREE *ist)
-{                               /* --- clean up on error */
-  ISNODE *node, *t;             /* to traverse the nodes */
-
-  assert(ist);                  /* check the function argument */
-  for (node = ist->lvls[ist->height]; node; ) {
-    t = node; node = node->succ; free(t); }
-  ist->lvls[ist->height] = NULL;/* delete all created nodes */
-  for (node = ist->lvls[ist->height -1]; node; node = node->succ)
-    node->chcnt = 0;            /* clear the child node counters */
-}  /* _cleanup() */             /* of the deepest nodes in the tree */
-
 /*----------------------------------------------------------------------
   Additional Rule Evaluation Measure Functions
 ----------------------------------------------------------------------*/
 
-static double _none (int set, int body, int head, int n)
+static double _none (SUPP set, SUPP body, SUPP head, SUPP n)
 { return 1; }                   /* --- no add. evaluation measure */
 
 /*--------------------------------------------------------------------*/
 
-static double _diff (int set, int body, int head, int n)
+static double _diff (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- absolute confidence difference */
   return fabs(head/(double)n -set/(double)body);
 }  /* _diff() */
 
 /*--------------------------------------------------------------------*/
 
-static double _quot (int set, int body, int head, int n)
+static double _quot (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- diff. of conf. quotient to 1 */
   double t;                     /* temporary buffer */
 
@@ -550,7 +1166,7 @@ static double _quot (int set, int body, int head, int n)
 
 /*--------------------------------------------------------------------*/
 
-static double _aimp (int set, int body, int head, int n)
+static double _aimp (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- abs. diff. of improvement to 1 */
   if ((head <= 0) || (body <= 0)) return 0;
   return fabs((set/(double)body) /(head/(double)n) -1);
@@ -558,7 +1174,7 @@ static double _aimp (int set, int body, int head, int n)
 
 /*--------------------------------------------------------------------*/
 
-static double _info (int set, int body, int head, int n)
+static double _info (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- information diff. to prior */
   double sum, t;                /* result, temporary buffer */
 
@@ -578,7 +1194,7 @@ static double _info (int set, int body, int head, int n)
 
 /*--------------------------------------------------------------------*/
 
-static double _chi2 (int set, int body, int head, int n)
+static double _chi2 (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- normalized chi^2 measure */
   double t;                     /* temporary buffer */
 
@@ -591,7 +1207,7 @@ static double _chi2 (int set, int body, int head, int n)
 
 /*--------------------------------------------------------------------*/
 
-static double _pval (int set, int body, int head, int n)
+static double _pval (SUPP set, SUPP body, SUPP head, SUPP n)
 {                               /* --- p-value from chi^2 measure */
   return chi2cdf(n*_chi2(set, body, head, n), 1);
 }  /* _pval() */
@@ -608,13 +1224,207 @@ static EVALFN *_evalfns[EM_UNKNOWN] = {
   /* EM_PVAL  6 */  _pval,      /* p-value of chi^2 measure */
 };                              /* table of evaluation functions */
 
+/*--------------------------------------------------------------------*/
+
+static double _cbound (ISTREE *ist, SUPP u1, SUPP u2)
+{                               /* --- bound measure of contrast sets */
+  SUPP   n1, n2;                /* sizes of the two groups */
+  double v, b;                  /* measure value and its bound */
+  EVALFN *eval;                 /* additional evaluation function */
+
+  assert(ist && (ist->mode & IST_CONTR));
+  n1   = COUNT(_getcnt(ist->lvls[0], ist->grps[0], ist->cwd));
+  n2   = COUNT(_getcnt(ist->lvls[0], ist->grps[1], ist->cwd));
+  eval = _evalfns[ist->arem];   /* get the group sizes and measure */
+  b = eval(0,  u1,    n2, n1+n2);   /* evaluate the corners */
+  v = eval(u2, u2,    n2, n1+n2); if (v > b) b = v;
+  v = eval(u2, u1+u2, n2, n1+n2); if (v > b) b = v;
+  return b;                     /* (group 2 is the "head" of a rule */
+}  /* _cbound() */              /* with the body set as the body) */
+
+/*----------------------------------------------------------------------
+  Candidate Identifier List Functions
+----------------------------------------------------------------------*/
+/* From some level on, the transactions are no longer scanned, but are */
+/* replaced by the candidates they contain (AprioriTid). A transaction */
+/* is represented by lists of counter indices, one for each node of    */
+/* the deepest level that holds candidates contained in the trans-     */
+/* action. The lists are recorded while this level is counted (so no  */
+/* extra pass is needed, AprioriHybrid). A candidate of the next level */
+/* is the union of two frequent sets of the same node, so it is        */
+/* counted by joining a list with itself. The joins also yield the     */
+/* lists for the next level. Lists with fewer than two indices cannot  */
+/* contain a candidate and are dropped, so that transactions vanish    */
+/* once they are exhausted.                                            */
+/*--------------------------------------------------------------------*/
+
+static void _tidfree (ISTREE *ist)
+{                               /* --- delete candidate id. lists */
+  int    i;                     /* loop variable */
+  TIDLST *tl;                   /* candidate identifier lists */
+
+  assert(ist);                  /* check the function argument */
+  if (!(tl = (TIDLST*)ist->tids)) return;
+  for (i = 0; i < 2; i++) {     /* delete both buffers */
+    if (tl[i].nds) free(tl[i].nds);
+    if (tl[i].ids) free(tl[i].ids);
+  }                             /* (current and next level) */
+  free(tl); ist->tids = NULL;   /* delete the list structures */
+}  /* _tidfree() */
+
+/*--------------------------------------------------------------------*/
+
+static int _tidres (TIDLST *tl, int n)
+{                               /* --- reserve space for a list */
+  size_t k;                     /* new buffer size */
+  void   *p;                    /* reallocated buffer */
+
+  assert(tl && (n > 0));        /* check the function arguments */
+  if (tl->ncnt >= tl->nsz) {    /* if the node vector is full */
+    k = (tl->nsz > 0) ? tl->nsz +(tl->nsz >> 1) : TD_BLKSIZE;
+    p = realloc(tl->nds, k *sizeof(ISNODE*));
+    if (!p) return -1;          /* enlarge the node vector */
+    tl->nds = (ISNODE**)p; tl->nsz = k;
+  }                             /* set the new vector and its size */
+  if (tl->icnt +(size_t)n +1 > tl->isz) {
+    k = (tl->isz > 0) ? tl->isz +(tl->isz >> 1) : TD_BLKSIZE;
+    if (k < tl->icnt +(size_t)n +1) k = tl->icnt +(size_t)n +1;
+    p = realloc(tl->ids, k *sizeof(int));
+    if (!p) return -1;          /* enlarge the index vector */
+    tl->ids = (int*)p; tl->isz = k;
+  }                             /* set the new vector and its size */
+  return 0;                     /* return 'ok' */
+}  /* _tidres() */
+
+/*--------------------------------------------------------------------*/
+
+static ISNODE* _tidchild (ISNODE *node, int item, int w)
+{                               /* --- get the child for an item */
+  int    i, n;                  /* child index, number of children */
+  int    *map;                  /* identifier map of the children */
+  ISNODE **vec;                 /* child node vector */
+
+  assert(node);                 /* check the function argument */
+  if ((n = node->chcnt) <= 0)   /* if there are no children, */
+    return NULL;                /* there is nothing to find */
+  vec = node->chvec;            /* get the child node vector */
+  if (node->offset >= 0) {      /* if a pure vector is used */
+    i = item -ID(vec[0]);       /* compute the child index */
+    return ((i >= 0) && (i < n)) ? vec[i] : NULL;
+  }                             /* return the child (if any) */
+  map = (n < node->size) ? (int*)(vec +n) : MAP(node, w);
+  i   = _bsearch(map, n, item); /* search the identifier map */
+  return (i >= 0) ? vec[i] : NULL;
+}  /* _tidchild() */            /* return the child (if any) */
+
+/*--------------------------------------------------------------------*/
+
+static int _tidenc (ISTREE *ist, ISNODE *node, int *set, int cnt,
+                    int min, TIDLST *tl)
+{                               /* --- count and encode a transaction */
+  int    i, k, n, x;            /* loop variables, counter index */
+  int    *map, *ids;            /* identifier map, counter indices */
+  ISNODE *child;                /* child node for an item */
+
+  assert(ist && node && tl      /* check the function arguments */
+     && (cnt >= 0) && (set || (cnt <= 0)));
+  if (min > 1) {                /* if not yet on the encoded level */
+    min--;                      /* one item less to the deepest nodes */
+    for (k = 0; k < cnt -min; k++) {
+      child = _tidchild(node, set[k], ist->cwd);
+      if (child && (_tidenc(ist, child, set+k+1, cnt-k-1, min, tl) < 0))
+        return -1;              /* encode the transaction */
+    }                           /* recursively for all children */
+    return 0;                   /* return 'ok' */
+  }
+  if (cnt <= 0) return 0;       /* check for remaining items */
+  if (_tidres(tl, cnt) < 0) return -1;
+  ids = tl->ids +tl->icnt +1;   /* get the index buffer */
+  map = (node->offset < 0) ? MAP(node, ist->cwd) : NULL;
+  for (n = i = k = 0; k < cnt; k++) {
+    if (map) {                  /* if an identifier map is used */
+      while ((i < node->size) && (map[i] < set[k])) i++;
+      if (i >= node->size) break;
+      if (map[i] != set[k]) continue;
+      x = i; }                  /* find the index by merging */
+    else {                      /* if a pure vector is used */
+      x = set[k] -node->offset; /* compute the counter index */
+      if (x <  0)          continue;
+      if (x >= node->size) break;
+    }                           /* compute the counter index */
+    if      (ist->cwd == 4) node->cnts[x]++;
+    else if (ist->cwd == 2) ((SCNT*)node->cnts)[x]++;
+    else                    ((LCNT*)node->cnts)[x]++;
+    ids[n++] = x;               /* count the candidate and note */
+  }                             /* its index for the next level */
+  if (n < 2) return 0;          /* if no candidate can follow, abort */
+  ids[-1] = n; tl->icnt += (size_t)n+1; /* store the list size */
+  tl->nds[tl->ncnt++] = node;   /* and the node of the list */
+  return 0;                     /* return 'ok' */
+}  /* _tidenc() */
+
+/*--------------------------------------------------------------------*/
+
+static int _tidjoin (ISTREE *ist, TIDLST *src, TIDLST *dst)
+{                               /* --- count by joining id. lists */
+  size_t g;                     /* loop variable for the lists */
+  int    a, b, i, j, k, m, n, x;/* loop variables, indices */
+  int    w;                     /* counter width */
+  int    *ids, *out;            /* input and output index lists */
+  int    *items;                /* items of the frequent sets */
+  int    *map;                  /* identifier map of a child */
+  ISNODE *node, *child;         /* current node and its child */
+
+  assert(ist && src && dst);    /* check the function arguments */
+  w = ist->cwd; items = ist->map;
+  dst->ncnt = dst->icnt = 0;    /* clear the output lists */
+  for (g = 0, ids = src->ids; g < src->ncnt; g++, ids += n+1) {
+    n = ids[0]; node = src->nds[g];
+    if (node->chcnt <= 0) continue; /* skip nodes without children */
+    map = (node->offset < 0) ? MAP(node, w) : NULL;
+    for (m = i = 0; i < n; i++) {   /* traverse the counter indices */
+      x = ids[i+1];             /* and collect the items of */
+      if (_getcnt(node, x, w) >= ist->supp)  /* the frequent sets */
+        items[m++] = (map) ? map[x] : node->offset +x;
+    }                           /* (only these may form candidates) */
+    for (a = 0; a < m-1; a++) { /* traverse the first sets */
+      child = _tidchild(node, items[a], w);
+      if (!child) continue;     /* get the child for the first set */
+      if (_tidres(dst, m-a-1) < 0) return -1;
+      out = dst->ids +dst->icnt +1;
+      map = (child->offset < 0) ? MAP(child, w) : NULL;
+      for (k = j = 0, b = a+1; b < m; b++) {
+        if (map) {              /* if an identifier map is used */
+          while ((j < child->size) && (map[j] < items[b])) j++;
+          if (j >= child->size) break;
+          if (map[j] != items[b]) continue;
+          x = j; }              /* find the index by merging */
+        else {                  /* if a pure vector is used */
+          x = items[b] -child->offset;
+          if (x <  0)           continue;
+          if (x >= child->size) break;
+        }                       /* compute the counter index */
+        if      (w == 4) child->cnts[x]++;
+        else if (w == 2) ((SCNT*)child->cnts)[x]++;
+        else             ((LCNT*)child->cnts)[x]++;
+        out[k++] = x;           /* count the candidate and note */
+      }                         /* its index for the next level */
+      if (k < 2) continue;      /* if no candidate can follow, skip */
+      out[-1] = k; dst->icnt += (size_t)k+1;  /* store the list size */
+      dst->nds[dst->ncnt++] = child; /* and the node of the list */
+    }
+  }
+  return 0;                     /* return 'ok' */
+}  /* _tidjoin() */
+
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
 
-ISTREE* ist_create (ITEMSET *set, int mode, int supp, double conf)
+ISTREE* ist_create (ITEMSET *set, int mode, SUPP supp, double conf)
 {                               /* --- create an item set tree */
-  int    cnt, n;                /* number of items, buffer */
+  int    cnt, n, w;             /* number of items, buffer, width */
+  SUPP   tac;                   /* number of transactions */
   ISTREE *ist;                  /* created item set tree */
   ISNODE *root;                 /* root node of the tree */
 
@@ -627,29 +1437,48 @@ ISTREE* ist_create (ITEMSET *set, int mode, int supp, double conf)
   if (!ist) return NULL;        /* allocate the tree body */
   ist->lvls = (ISNODE**)malloc(BLKSIZE *sizeof(ISNODE*));
   if (!ist->lvls) {                  free(ist); return NULL; }
+  ist->arns = (void**)  malloc(BLKSIZE *sizeof(void*));
+  if (!ist->arns) { free(ist->lvls); free(ist); return NULL; }
   ist->buf  = (int*)    malloc(BLKSIZE *sizeof(int));
-  if (!ist->buf)  { free(ist->lvls); free(ist); return NULL; }
+  if (!ist->buf)  { free(ist->arns);
+                    free(ist->lvls); free(ist); return NULL; }
+  ist->htree = NULL;            /* there is no hash tree yet */
+  ist->tri   = NULL;            /* and no triangular array */
+  ist->tofs  = NULL;
+  ist->tcnt  = 0;
+  ist->tids  = NULL;            /* and no candidate id. lists */
+  ist->grps[0] = ist->grps[1] = -1;   /* and no group labels */
   ist->map  = (int*)    malloc(cnt *sizeof(int));
-  if (!ist->map)  { free(ist->buf);
+  if (!ist->map)  { free(ist->buf);  free(ist->arns);
                     free(ist->lvls); free(ist); return NULL; }
   #ifdef ARCH64                 /* if 64 bit architecture, */
   n = cnt +(cnt & 1);           /* pad counters to even number */
   #else                         /* on 32 bit systems, however, */
   n = cnt;                      /* use the number of items directly */
   #endif
-  ist->lvls[0] = ist->curr =    /* allocate a root node */
-  root = (ISNODE*)calloc(1, sizeof(ISNODE) +(n-1) *sizeof(int));
-  if (!root)        { free(ist->map);  free(ist->buf);
+  tac = is_gettac(set);         /* choose the counter width */
+  w   = (tac <= 0x7fff) ? 2 : (tac <= INT_MAX) ? 4 : 8;
+  if      (mode & IST_CNT64) w = 8;  /* enforce a minimal */
+  else if ((mode & IST_CNT32) && (w < 4)) w = 4;  /* counter width */
+  ist->arns[0] = ist->lvls[0] = /* allocate a root node */
+  ist->curr    = root = (ISNODE*)calloc(1, sizeof(ISNODE)
+                                     +(CINTS(n, w)-1) *sizeof(int));
+  if (!root)        { free(ist->map);  free(ist->buf);  free(ist->arns);
                       free(ist->lvls); free(ist); return NULL; }
+  assert((w < 8) || !((size_t)root->cnts & 7));
 
   /* --- initialize structures --- */
   ist->set     = set;           /* copy parameters to the structure */
   ist->mode    = mode;
-  ist->tacnt   = is_gettac(set);
+  ist->tacnt   = tac;
+  ist->thcnt   = 1;
+  ist->cwd     = w;             /* (all counts are at most tacnt) */
+  _selsimd();                   /* select the search functions */
   ist->vsz     = BLKSIZE;
   ist->height  = 1;
+  ist->ucnt    = 1;
   ist->rule    = (supp > 0) ? supp : 1;
-  if (mode & IST_HEAD) supp = (int)ceil(conf *supp);
+  if (mode & IST_HEAD) supp = (SUPP)ceil(conf *(double)supp);
   ist->supp    = (supp > 0) ? supp : 1;
   ist->conf    = conf;
   #ifdef BENCH                  /* if benchmark version */
@@ -657,16 +1486,18 @@ ISTREE* ist_create (ITEMSET *set, int mode, int supp, double conf)
   ist->cpcnt   = ist->cpnec = 0;
   ist->bytes   = sizeof(ISTREE) +cnt *sizeof(char) +8
                + BLKSIZE *sizeof(ISNODE*) +8
+               + BLKSIZE *sizeof(void*) +8
                + BLKSIZE *sizeof(int) +8
                + cnt     *sizeof(int) +8;
   #endif                        /* initialize the benchmark variables */
   ist_init(ist, 1, EM_NONE, 1); /* initialize rule extraction */
   root->parent = root->succ = NULL;
+  root->chvec  = NULL;
   root->offset = root->id   = 0;
   root->chcnt  = 0;             /* initialize the root node */
   root->size   = n;
   while (--cnt >= 0)            /* copy the item frequencies */
-    root->cnts[cnt] = is_getfrq(set, cnt); 
+    _setcnt(root, cnt, ist->cwd, is_getfrq(set, cnt));
   return ist;                   /* return created item set tree */
 }  /* ist_create() */
 
@@ -674,17 +1505,20 @@ ISTREE* ist_create (ITEMSET *set, int mode, int supp, double conf)
 
 void ist_delete (ISTREE *ist)
 {                               /* --- delete an item set tree */
-  int    i;                     /* loop variables */
-  ISNODE *node, *t;             /* to traverse the nodes */
+  int i;                        /* loop variable */
 
   assert(ist);                  /* check the function argument */
-  for (i = ist->height; --i >= 0; ) {
-    for (node = ist->lvls[i]; node; ) {
-      t = node; node = node->succ; free(t); }
-  }                             /* delete all nodes, */
+  for (i = ist->height; --i >= 0; )
+    free(ist->arns[i]);         /* delete the arenas of all levels */
+  free(ist->arns);              /* (and thus all nodes), */
   free(ist->lvls);              /* the level vector, */
   free(ist->map);               /* the identifier map, */
   free(ist->buf);               /* the path buffer, */
+  if (ist->htree)               /* the hash tree */
+    ht_delete(ist->htree);      /* (if there is one), */
+  if (ist->tri) {               /* the triangular array */
+    free(ist->tri); free(ist->tofs); }  /* (if there is one), */
+  _tidfree(ist);                /* the candidate id. lists, */
   free(ist);                    /* and the tree body */
 }  /* ist_delete() */
 
@@ -692,30 +1526,131 @@ void ist_delete (ISTREE *ist)
 
 void ist_count (ISTREE *ist, int *set, int cnt)
 {                               /* --- count transaction in tree */
+  int min, h;                   /* loop variable, last level */
+
   assert(ist                    /* check the function arguments */
      && (cnt >= 0) && (set || (cnt <= 0)));
-  if (cnt >= ist->height)       /* recursively count transaction */
-    _count(ist->lvls[0], set, cnt, ist->height);
-}  /* ist_count() */
+  if (ist->tri) {               /* if to count pairs, use the array */
+    CNTFN(ist)->cnttri(ist->tri, ist->tofs, set, 0, cnt, 1); return; }
+  h = ist->height;              /* get the deepest level */
+  if (ist->htree) {             /* if to count with a hash tree */
+    _htadd(ist, ht_match(ist->htree, set, cnt), 1); h--; }
+  for (min = ist->height -ist->ucnt +1; min <= h; min++)
+    if (cnt >= min)             /* recursively count transaction */
+      CNTFN(ist)->count(ist->lvls[0], set, cnt, min, 1, NULL);
+}  /* ist_count() */            /* in all uncounted levels */
 
 /*--------------------------------------------------------------------*/
 
 void ist_countx (ISTREE *ist, TATREE *tat)
 {                               /* --- count transaction in tree */
+  int min, h;                   /* loop variable, last level */
+
   assert(ist && tat);           /* check the function arguments */
-  _countx(ist->lvls[0], tat, ist->height);
-}  /* ist_countx() */           /* recursively count the trans. tree */
+  if (ist->tri) {               /* if to count pairs, use the array */
+    _tricountx(ist, tat, (int*)(ist->tofs +is_cnt(ist->set)), 0);
+    return;                     /* (buffer follows the row offsets) */
+  }
+  h = ist->height;              /* get the deepest level */
+  if (ist->htree) {             /* if to count with a hash tree, */
+    _htcountx(ist, tat, 0); h--; }      /* expand the transactions */
+  for (min = ist->height -ist->ucnt +1; min <= h; min++) {
+    #ifndef NOTHREADS           /* if to use multiple threads */
+    if (((ist->thcnt > 1) || (ist->thcnt < -1))
+    &&  (tat_size(tat) > 1) && (tat_max(tat) >= min)
+    &&  (_parcnt(ist, tat, NULL, min) == 0))
+      continue;                 /* count the children of the root */
+    #endif                      /* of the t.a. tree in parallel */
+    CNTFN(ist)->countx(ist->lvls[0], tat, min, NULL);
+  }                             /* recursively count the trans. tree */
+}  /* ist_countx() */           /* in all uncounted levels */
 
 /*--------------------------------------------------------------------*/
 
+void ist_counts (ISTREE *ist, TASET *taset)
+{                               /* --- count transaction set in tree */
+  int i, min;                   /* loop variables */
+  int *set, cnt;                /* transaction to count */
+
+  assert(ist && taset);         /* check the function arguments */
+  min = ist->height -ist->ucnt +1;
+  #ifndef NOTHREADS             /* if to use multiple threads */
+  if (((ist->thcnt > 1) || (ist->thcnt < -1))
+  &&  !ist->htree && !ist->tri && (tas_cnt(taset) > PC_BLKSIZE)) {
+    for ( ; min <= ist->height; min++)
+      if (_parcnt(ist, NULL, taset, min) != 0) break;
+  }                             /* count blocks of transactions */
+  #endif                        /* in parallel (level by level) */
+  if (min > ist->height) return;/* if all levels are counted, abort */
+  if (min <= ist->height -ist->ucnt +1) {
+    for (i = tas_cnt(taset); --i >= 0; )
+      ist_count(ist, tas_tract(taset, i), tas_tsize(taset, i));
+    return;                     /* count the transactions serially */
+  }                             /* (all uncounted levels at once) */
+  for ( ; min <= ist->height; min++) {
+    for (i = tas_cnt(taset); --i >= 0; ) {
+      set = tas_tract(taset, i); cnt = tas_tsize(taset, i);
+      if (cnt >= min) CNTFN(ist)->count(ist->lvls[0], set, cnt, min,
+                                        1, NULL);
+    }                           /* count the remaining levels */
+  }                             /* serially (if parallel counting */
+}  /* ist_counts() */           /* failed for some level) */
+
+/*--------------------------------------------------------------------*/
+
+int ist_tidcnt (ISTREE *ist, TASET *taset)
+{                               /* --- count with candidate id. lists */
+  int    i, h;                  /* loop variable, encoded level */
+  double size;                  /* estimated size of the lists */
+  TIDLST *tl, t;                /* candidate identifier lists */
+  ISNODE *node;                 /* to traverse the encoded level */
+
+  assert(ist && taset);         /* check the function arguments */
+  if (!(ist->mode & IST_TIDS)   /* if not to use id. lists or if */
+  ||  (ist->ucnt > 1)           /* several levels are to be counted */
+  ||  ist->htree || ist->tri    /* or another counting structure */
+  ||  (ist->height < 3)) {      /* is used or the tree is too small, */
+    _tidfree(ist); return 0; }  /* count the transactions instead */
+  tl = (TIDLST*)ist->tids;      /* get the candidate id. lists */
+  if (tl) {                     /* if the lists exist, count the */
+    if (_tidjoin(ist, tl, tl+1) < 0)   /* new level by joining */
+      return -1;                /* the lists of the level above it */
+    t = tl[0]; tl[0] = tl[1]; tl[1] = t;
+    return 1;                   /* the new lists become those */
+  }                             /* of the current level */
+  h = ist->height -2;           /* get the deepest counted level */
+  for (size = 0, node = ist->lvls[h]; node; node = node->succ)
+    for (i = node->size; --i >= 0; )
+      if (_getcnt(node, i, ist->cwd) >= ist->supp)
+        size += (double)_getcnt(node, i, ist->cwd);
+  if (size >= (double)tas_total(taset))
+    return 0;                   /* if the lists would be too large, */
+                                /* count the transactions instead */
+  tl = (TIDLST*)calloc(2, sizeof(TIDLST));
+  if (!tl) return -1;           /* create the list structures */
+  ist->tids = tl;               /* and count the transactions */
+  for (i = tas_cnt(taset); --i >= 0; )
+    if (_tidenc(ist, ist->lvls[0], tas_tract(taset, i),
+                tas_tsize(taset, i), h+2, tl) < 0)
+      return -1;                /* while replacing them by */
+  return 1;                     /* the candidates they contain */
+}  /* ist_tidcnt() */
+
+/*--------------------------------------------------------------------*/
+
+static int _trilvl (ISTREE *ist);
+
 int ist_check (ISTREE *ist, char *marks)
 {                               /* --- check item usage */
   int i, n;                     /* loop variable, number of items */
 
   assert(ist);                  /* check the function argument */
+  if (ist->ucnt > 1) _prune(ist);  /* prune optimistic levels */
+  if (ist->tri && (_trilvl(ist) < 0))
+    return -1;                  /* create the second level */
   for (i = ist->lvls[0]->size; --i >= 0; )
     marks[i] = 0;               /* clear the marker vector */
-  _checkuse(ist->lvls[0], marks, ist->supp);
+  _checkuse(ist->lvls[0], marks, ist->supp, ist->cwd);
   for (n = 0, i = ist->lvls[0]->size; --i >= 0; )
     if (marks[i]) n++;          /* count used items */
   return n;                     /* and return this number */
@@ -723,19 +1658,168 @@ int ist_check (ISTREE *ist, char *marks)
 
 /*--------------------------------------------------------------------*/
 
-int ist_addlvl (ISTREE *ist)
-{                               /* --- add a level to item set tree */
-  int    i, n, c;               /* loop variable, counter, buffer */
-  ISNODE **ndp;                 /* to traverse the nodes */
-  ISNODE *node;                 /* new (reallocated) node */
-  ISNODE **end;                 /* end of new level node list */
-  ISNODE *cur;                  /* current node in new level */
-  ISNODE *frst;                 /* first child of current node */
-  ISNODE *last;                 /* last  child of current node */
-  ISNODE **vec;                 /* child node vector */
-  int    *map;                  /* identifier map */
+void ist_setsupp (ISTREE *ist, SUPP supp)
+{                               /* --- raise the minimal support */
+  SUPP s;                       /* minimal support of an item set */
+
+  assert(ist);                  /* check the function argument */
+  if (supp > ist->rule)         /* raise the minimal support */
+    ist->rule = supp;           /* of a rule body */
+  s = (ist->mode & IST_HEAD)    /* a rule with the given support */
+    ? supp : (SUPP)ceil(ist->conf *(double)supp);
+  if (s > ist->supp)            /* (body or body & head) needs a set */
+    ist->supp = s;              /* with at least this support */
+}  /* ist_setsupp() */          /* (later levels are created with it) */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP _tricnt (ISTREE *ist, int i, int j)
+{                               /* --- get a pair counter */
+  size_t k;                     /* index of the counter */
+
+  assert(ist && ist->tri && (i >= 0) && (i < j));
+  if (j >= ist->tcnt) return 0; /* check for an item in the array */
+  k = ist->tofs[i] +(size_t)(j-i-1);
+  if (ist->cwd == 2) return (SUPP)((SCNT*)ist->tri)[k];
+  if (ist->cwd == 4) return (SUPP)((int*) ist->tri)[k];
+  return (SUPP)((LCNT*)ist->tri)[k];
+}  /* _tricnt() */
+
+/*--------------------------------------------------------------------*/
+
+static void _tricopy (ISTREE *ist, ISNODE *node)
+{                               /* --- copy pair counters to a node */
+  int i, k, n;                  /* loop variable, item identifiers */
+
+  assert(ist && node && ist->tri && !node->parent->parent);
+  n = ist->tcnt;                /* get the number of items */
+  for (i = 0; i < node->size; i++) {
+    k = (node->offset >= 0) ? node->offset +i : MAP(node, ist->cwd)[i];
+    if ((k > ID(node)) && (k < n))  /* traverse the counters and */
+      _setcnt(node, i, ist->cwd, _tricnt(ist, ID(node), k));
+  }                             /* copy the corresponding pair */
+}  /* _tricopy() */             /* counters (skip padding counters) */
+
+/*--------------------------------------------------------------------*/
+
+static int _gencands (GENDATA *gd)
+{                               /* --- collect the new nodes */
+  int    i, k, n, c, c2;        /* loop variables, counters */
+  int    id, size;              /* item identifier, size of a node */
+  int    frst, last;            /* first and last child item */
+  int    h;                     /* index of the node header */
+  ISTREE *ist = gd->ist;        /* item set tree to extend */
+  ISNODE *node;                 /* to traverse the nodes of the range */
   void   *p;                    /* temporary buffer */
 
+  assert(gd);                   /* check the function argument */
+  gd->rec = (int*)malloc((gd->rsz = RECSIZE) *sizeof(int));
+  if (!gd->rec) return gd->err = -1;  /* create a record buffer */
+  for (node = gd->beg; node != gd->end; node = node->succ) {
+    if (gd->rcnt +2 > gd->rsz){ /* if the record buffer is full */
+      p = realloc(gd->rec, (gd->rsz +gd->rsz) *sizeof(int));
+      if (!p) return gd->err = -1;
+      gd->rec = (int*)p; gd->rsz += gd->rsz;
+    }                           /* enlarge the record buffer */
+    h = gd->rcnt; gd->rcnt += 2;/* reserve the node header */
+    for (frst = last = c = i = 0; i < node->size; i++) {
+      n = _child(ist, node, i, gd->s_min, gd->s_body,
+                 gd->buf, gd->map, &id);
+      if (gd->pairs) {          /* if to keep only frequent pairs */
+        for (c2 = k = 0; k < n; k++)
+          if ((_tricnt(ist, id & ~F_HDONLY, gd->map[k]) >= gd->s_min)
+          ||  ((ist->mode & IST_CONTR)
+          &&   (is_getapp(ist->set, gd->map[k]) == IST_HEAD)))
+            gd->map[c2++] = gd->map[k];
+        n = c2;                 /* remove the candidate items */
+      }                         /* that form infrequent pairs */
+      if (n <= 0) continue;     /* check whether a child is needed */
+      k = _layout(ist, gd->map, n, &size);
+      if (gd->rcnt +size +4 > gd->rsz) {
+        n = gd->rsz +((gd->rsz > size +4) ? gd->rsz : size +4);
+        p = realloc(gd->rec, n *sizeof(int));
+        if (!p) return gd->err = -1;
+        gd->rec = (int*)p; gd->rsz = n;
+      }                         /* enlarge the record buffer */
+      gd->rec[gd->rcnt++] = id; /* store the item identifier, */
+      gd->rec[gd->rcnt++] = size;  /* the size of the counters, */
+      gd->rec[gd->rcnt++] = k;  /* and the number of integers */
+      if (k == CINTS(size, ist->cwd))  /* if to use a pure vector, */
+        gd->rec[gd->rcnt++] = gd->map[0];  /* store the offset */
+      else {                    /* if to use an identifier map, */
+        memcpy(gd->rec +gd->rcnt, gd->map, size *sizeof(int));
+        gd->rcnt += size;       /* copy the identifier map */
+      }                         /* to the record buffer */
+      gd->total += ALIGN(sizeof(ISNODE) +(k-1) *sizeof(int));
+      gd->ccnt  += (size_t)size;/* sum the arena size and counters */
+      if (gd->cmax && (gd->ccnt > gd->cmax))
+        return gd->err = 1;     /* check the number of counters */
+      last = id & ~F_HDONLY;    /* note the first and last item */
+      if (c++ <= 0) frst = last;
+      #ifdef BENCH              /* if benchmark version */
+      gd->scnec += n;           /* sum the necessary counters, */
+      gd->sccnt += size;        /* the number of counters, */
+      gd->bytes += sizeof(ISNODE) +(k-1) *sizeof(int);
+      #endif                    /* and the memory usage */
+    }
+    if (c <= 0) k = 0;          /* decide on the node structure: */
+    else if (node->offset >= 0) /* if a pure counter vector is used, */
+      k = last -frst +1;        /* always add a pure child vector */
+    else if (2*c > node->size)  /* if a single id. map is best, */
+      k = node->size;           /* only add a child vector */
+    else k = c;                 /* otherwise add a vector and a map */
+    gd->rec[h] = c; gd->rec[h+1] = k;  /* store the node header */
+    if (c <= 0) continue;       /* if there are no children, skip */
+    gd->total += ALIGN(k *sizeof(ISNODE*)
+               + (((node->offset < 0) && (k < node->size))
+               ? k *sizeof(int) : 0));
+    #ifdef BENCH                /* if benchmark version */
+    gd->cpnec += c;             /* sum the number of necessary */
+    gd->cpcnt += k;             /* and of all child pointers */
+    if ((node->offset >= 0) || (node->size == k))
+         gd->bytes += k * sizeof(ISNODE*);
+    else gd->bytes += k *(sizeof(ISNODE*) +sizeof(int));
+    #endif                      /* determine the memory usage */
+  }
+  return 0;                     /* return 'ok' */
+}  /* _gencands() */
+
+/*--------------------------------------------------------------------*/
+#ifndef NOTHREADS
+
+static void* _genthrd (void *arg)
+{                               /* --- candidate generation thread */
+  _gencands((GENDATA*)arg);     /* collect the new nodes of a range */
+  return NULL;                  /* return a dummy result */
+}  /* _genthrd() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static int _addlvl (ISTREE *ist, int mode)
+{                               /* --- add a level to item set tree */
+  int     i, k, n, c;           /* loop variables, counters */
+  int     id, size;             /* item identifier, size of a node */
+  int     h;                    /* index in the child vector */
+  int     m, t;                 /* number of ranges, range index */
+  int     *r;                   /* to traverse the records */
+  size_t  total;                /* size of the level arena */
+  size_t  ccnt, pcnt;           /* numbers of counters of levels */
+  char    *arn;                 /* arena for the new level */
+  ISNODE  *node;                /* to traverse the deepest nodes */
+  ISNODE  **end;                /* end of new level node list */
+  ISNODE  *cur;                 /* current node in new level */
+  ISNODE  **vec;                /* child node vector */
+  int     *map;                 /* identifier map */
+  int     *ids;                 /* identifier map of a new node */
+  void    *p;                   /* temporary buffer */
+  GENDATA *gds;                 /* candidate generation data */
+  #ifndef NOTHREADS             /* if to use multiple threads */
+  pthread_t *tids;              /* identifiers of the threads */
+  char      *run;               /* whether a thread was started */
+  double    sum, wgt;           /* (cumulated) work of the nodes */
+  #endif
+
   assert(ist);                  /* check the function arguments */
 
   /* --- enlarge level vector --- */
@@ -744,100 +1828,407 @@ int ist_addlvl (ISTREE *ist)
     p = realloc(ist->lvls, n *sizeof(ISNODE*));
     if (!p) return -1;          /* enlarge the level vector */
     ist->lvls = (ISNODE**)p;    /* and set the new vector */
+    p = realloc(ist->arns,   n *sizeof(void*));
+    if (!p) return -1;          /* enlarge the arena vector */
+    ist->arns = (void**)p;      /* and set the new vector */
     p = realloc(ist->buf,    n *sizeof(int));
     if (!p) return -1;          /* enlarge the buffer vector */
     ist->buf = (int*)p;         /* and set the new vector */
     ist->vsz = n;               /* set the new vector size */
-  }                             /* (applies to buf and levels) */
-  end  = ist->lvls +ist->height;
-  *end = NULL;                  /* start a new tree level */
+  }                             /* (applies to buf, arenas, levels) */
+  pcnt = 0;                     /* init. the number of counters */
+  if (mode == AL_OPTIM) {       /* if to add an optimistic level, */
+    _flag(ist, ist->height-1,   /* mark the non-candidates */
+          (ist->ucnt > 1) ? 0 : ist->supp,  /* of the deepest level */
+          (ist->ucnt > 1) ? 0 : ist->rule);
+    for (node = ist->lvls[ist->height-1]; node; node = node->succ)
+      pcnt += (size_t)node->size;   /* count the counters */
+  }                             /* of the deepest level */
+
+  /* --- split the deepest level --- */
+  m = 1;                        /* default: a single range */
+  #ifndef NOTHREADS             /* if to use multiple threads */
+  k = (ist->thcnt < 0) ? -ist->thcnt : ist->thcnt;
+  for (i = 0, wgt = 0, node = ist->lvls[ist->height-1]; node;
+       node = node->succ) {     /* traverse the deepest nodes */
+    wgt += (double)node->size *node->size; i++; }
+  if ((k > 1) && (i >= k *GN_MINNODES) && (wgt >= GN_MINWORK))
+    m = k;                      /* use several threads if the level */
+  #endif                        /* is large enough (work ~ size^2) */
+  gds = (GENDATA*)calloc(m, sizeof(GENDATA));
+  if (!gds) return -1;          /* create the generation data */
+  c = is_cnt(ist->set);         /* get the size of the id. maps */
+  for (k = 0; k < m; k++) {     /* initialize the generation data */
+    gds[k].ist    = ist;
+    gds[k].s_min  = (mode == AL_OPTIM) ? 0 : ist->supp;
+    gds[k].s_body = (mode == AL_OPTIM) ? 0 : ist->rule;
+    gds[k].pairs  = (mode == AL_PAIRS);
+    gds[k].cmax   = AL_MAXGROW *pcnt;
+    if (k <= 0) {               /* the first range uses the buffers */
+      gds[k].buf = ist->buf +ist->vsz; gds[k].map = ist->map;
+      continue;                 /* of the item set tree, */
+    }                           /* all others private buffers */
+    gds[k].map = (int*)malloc((c +ist->vsz) *sizeof(int));
+    if (!gds[k].map) { m = k; break; }
+    gds[k].buf = gds[k].map +c +ist->vsz;
+  }                             /* (too few buffers: fewer ranges) */
+  gds[0].beg   = ist->lvls[ist->height-1];
+  gds[m-1].end = NULL;          /* set the first and last bound */
+  #ifndef NOTHREADS             /* if to use multiple threads */
+  node = gds[0].beg;            /* split the deepest nodes */
+  for (sum = 0, k = 1; k < m; k++) {
+    while (node && (sum *m < k *wgt)) {
+      sum += (double)node->size *node->size; node = node->succ; }
+    gds[k-1].end = gds[k].beg = node;
+  }                             /* (ranges with about equal work) */
+
+  /* --- collect the new nodes --- */
+  tids = NULL; run = NULL;      /* start the generation threads */
+  if (m > 1) {                  /* (thread creation may fail) */
+    tids = (pthread_t*)malloc(m *sizeof(pthread_t));
+    run  = (char*)calloc(m, sizeof(char));
+  }
+  if (tids && run)              /* if the thread data was created */
+    for (k = 1; k < m; k++)     /* start the generation threads */
+      run[k] = (pthread_create(tids+k, NULL, _genthrd, gds+k) == 0);
+  _gencands(gds);               /* process the first range */
+  for (k = 1; k < m; k++) {     /* and wait for the other threads */
+    if (run && run[k]) pthread_join(tids[k], NULL);
+    else               _gencands(gds+k);
+  }                             /* (process ranges of failed */
+  free(run); free(tids);        /* threads in the calling thread) */
+  #else                         /* if to use a single thread, */
+  _gencands(gds);               /* collect the new nodes */
+  #endif
+  for (total = ccnt = 0, i = k = 0; k < m; k++) {
+    i |= gds[k].err;            /* check for errors and */
+    total += gds[k].total;      /* sum the arena sizes */
+    ccnt  += gds[k].ccnt;       /* and the numbers of counters */
+    #ifdef BENCH                /* if benchmark version */
+    ist->scnec += gds[k].scnec; ist->sccnt += gds[k].sccnt;
+    ist->cpnec += gds[k].cpnec; ist->cpcnt += gds[k].cpcnt;
+    ist->bytes += gds[k].bytes; /* sum the benchmark values */
+    #endif                      /* of all ranges */
+  }
+  if ((i == 0) && (pcnt > 0) && (ccnt > AL_MAXGROW *pcnt))
+    i = 1;                      /* do not add an optimistic level */
+                                /* that grows too much (the counters */
+                                /* of most candidates are useless) */
+  if (i != 0) total = 0;        /* on an error or growth, abort */
+  if (total <= 0) arn = NULL;   /* if no child is needed, no arena */
+  else {                        /* otherwise allocate the arena */
+    arn = (char*)malloc(total); /* for all nodes of the new level */
+    if (!arn) i = -1;           /* (all memory is allocated now) */
+  }
+  if (i != 0) {                 /* if an error occurred */
+    for (k = m; --k >= 0; ) {   /* delete the generation data */
+      free(gds[k].rec); if (k > 0) free(gds[k].map); }
+    free(gds); return (i < 0) ? -1 : 1;
+  }                             /* and abort the function */
+  ist->arns[ist->height] = arn; /* note the arena of the new level */
 
   /* --- add tree level --- */
-  for (ndp = ist->lvls +ist->height -1; *ndp; ndp = &(*ndp)->succ) {
-    frst = last = NULL;         /* traverse the deepest nodes */
-    for (i = n = 0; i < (*ndp)->size; i++) {
-      cur = _child(ist, *ndp, i, ist->supp, ist->rule);
-      if (!cur) continue;       /* create a child if necessary */
-      if (cur == (void*)-1) { _cleanup(ist); return -1; }
-      if (!frst) frst = cur;    /* note first and last child node */
-      *end = last = cur;        /* add node at the end of the list */
-      end  = &cur->succ; n++;   /* that contains the new level */
-    }                           /* and advance end pointer */
-    if (n <= 0) {               /* if no child node was created, */
-      (*ndp)->chcnt = F_SKIP; continue; }       /* skip the node */
-    #ifdef BENCH                /* if benchmark version */
-    ist->cpnec += n;            /* sum the number of necessary */
-    #endif                      /* child pointers */
-    node = *ndp;                /* decide on the node structure: */
-    if (node->offset >= 0) {    /* if a pure counter vector is used, */
-      n = ID(last)-ID(frst)+1;  /* always add a pure child vector */
-      i = (node->size -1) *sizeof(int) +n *sizeof(ISNODE*); }
-    else if (2*n > node->size){ /* if a single id. map is best, */
-      n = node->size;           /* only add a child vector */
-      i = (n+n-1) *sizeof(int) +n *sizeof(ISNODE*); }
-    else {                      /* if two identifier maps are best, */
-      i = node->size;           /* add a child vector and a map */
-      i = (i+i-1) *sizeof(int) +n *(sizeof(ISNODE*) +sizeof(int));
-    }                           /* get size of additional vectors */
-    node = (ISNODE*)realloc(node, sizeof(ISNODE) +i);
-    if (!node) { _cleanup(ist); return -1; }
-    node->chcnt = n;            /* add a child vector to the node */
-    #ifdef BENCH                /* if benchmark version */
-    ist->cpcnt += n;            /* sum the number of child pointers */
-    if ((node->offset >= 0) || (node->size == n))
-         ist->bytes += n * sizeof(ISNODE*);
-    else ist->bytes += n *(sizeof(ISNODE*) +sizeof(int));
-    #endif                      /* determine the memory usage */
-    if ((node != *ndp) && node->parent) {
-      last = node->parent;      /* adapt the ref. from the parent */
-      if (last->offset >= 0) {  /* if a pure vector is used */
-        vec = (ISNODE**)(last->cnts +last->size);
-        vec[(vec[0] != *ndp) ? ID(node) -ID(vec[0]) : 0] = node; }
-      else {                    /* if an identifier map is used */
-        map = last->cnts +(i = last->size);
-        vec = (ISNODE**)(map+i);/* get identifier map, child vector, */
-        c   = last->chcnt & ~F_SKIP;   /* and the number of children */
-        if (c < i)              /* if a secondary id. map exists, */
-          map = (int*)(vec +(i = c));  /* get this identifier map */
-        vec[_bsearch(map, i, ID(node))] = node;
-      }                         /* find the proper index and */
-    }                           /* set the new child pointer */
-    *ndp = node;                /* set new (reallocated) node */
-    if (node->offset >= 0) {    /* if to use pure vectors */
-      vec = (ISNODE**)(node->cnts +node->size);
-      while (--n >= 0) vec[n] = NULL;
-      i = ID(frst);             /* get item identifier of first child */
-      for (cur = frst; cur; cur = cur->succ) {
-        vec[ID(cur)-i] = cur;   /* set the child node pointer */
-        cur->parent    = node;  /* and the parent pointer */
-      } }                       /* in the new node */
-    else if (n < node->size) {  /* if two identifier maps are used */
-      vec = (ISNODE**)(node->cnts +node->size +node->size);
-      map = (int*)(vec +n);     /* get the secondary identifier map */
-      for (i = 0, cur = frst; cur; cur = cur->succ) {
-        vec[i]      = cur;      /* set the child node pointer, */
-        map[i++]    = ID(cur);  /* the identifier map entry, */
-        cur->parent = node;     /* and the parent pointer */
-      } }                       /* in the new node */
-    else {                      /* if one identifier map is used */
-      map = node->cnts +(i = node->size);
-      vec = (ISNODE**)(map +i); /* get id. map and child vector */
-      while (--n >= 0) vec[n] = NULL;
-      for (cur = frst; cur; cur = cur->succ) {
-        vec[_bsearch(map, i, ID(cur))] = cur;
-        cur->parent = node;     /* set the child node pointer */
-      }                         /* and the parent pointer */
-    }                           /* in the new node */
+  end  = ist->lvls +ist->height;
+  *end = NULL;                  /* start a new tree level */
+  for (t = 0, r = gds[0].rec, node = ist->lvls[ist->height -1]; node;
+       node = node->succ) {     /* traverse the deepest nodes */
+    while (node == gds[t].end)  /* if at the end of a range, */
+      r = gds[++t].rec;         /* get the records of the next */
+    c = *r++; n = *r++;         /* get the node header */
+    if (c <= 0) {               /* if no child node is needed, */
+      node->chcnt = F_SKIP; continue; }         /* skip the node */
+    vec = (ISNODE**)arn;        /* get the child vector and */
+    map = ((node->offset < 0) && (n < node->size))
+        ? (int*)(vec +n) : NULL;/* the secondary identifier map */
+    arn += ALIGN(n *sizeof(ISNODE*) +((map) ? n *sizeof(int) : 0));
+    for (i = n; --i >= 0; ) vec[i] = NULL;
+    node->chvec = vec;          /* clear and set the child vector */
+    node->chcnt = n;            /* and the number of child pointers */
+    for (h = k = 0; k < c; k++) {
+      cur  = (ISNODE*)arn;      /* get the next node from the arena */
+      size = r[1];              /* and the size of its counters */
+      arn += ALIGN(sizeof(ISNODE) +(r[2]-1) *sizeof(int));
+      cur->parent = node;       /* set pointer to parent node */
+      cur->succ   = NULL;       /* and clear successor pointer */
+      cur->chvec  = NULL;       /* there are no children yet */
+      cur->id     = r[0];       /* set the item id. and flag */
+      cur->chcnt  = 0;          /* and the number of children */
+      cur->size   = size;       /* set size of counter vector */
+      cur->sofs   = 0;          /* and the shadow offset */
+      assert((ist->cwd < 8) || !((size_t)cur->cnts & 7));
+      if (r[2] == CINTS(size, ist->cwd)) {  /* if a pure vector, */
+        cur->offset = r[3];     /* note the first item as an offset */
+        r += 4; }               /* and skip the record */
+      else {                    /* if to use an identifier map, */
+        cur->offset = -1;       /* use the offset as an indicator */
+        ids = MAP(cur, ist->cwd);
+        memcpy(ids, r+3, size *sizeof(int));
+        if (r[2] > CINTS(size, ist->cwd) +size) {
+          cur->offset = -2;     /* if the map is long enough, */
+          _sxbuild(ids, size, ids +size);
+        }                       /* build a search index for it */
+        r += 3 +size;           /* copy the identifier map */
+      }                         /* and skip the record */
+      memset(cur->cnts, 0, CINTS(size, ist->cwd) *sizeof(int));
+      if (mode >= AL_PAIRS)     /* if to create the second level, */
+        _tricopy(ist, cur);     /* copy the pair counters */
+      *end = cur;               /* add node at the end of the list */
+      end  = &cur->succ;        /* that contains the new level */
+      id   = ID(cur);           /* get the item identifier */
+      if      (node->offset >= 0)  /* if a pure vector is used */
+        vec[id -ID(vec[0] ? vec[0] : cur)] = cur;
+      else if (map) {           /* if two identifier maps are used */
+        vec[k] = cur; map[k] = id; }
+      else {                    /* if one identifier map is used */
+        while (MAP(node, ist->cwd)[h] < id) h++;
+        vec[h] = cur;           /* find the index of the item */
+      }                         /* and set the child node pointer */
+    }
   }
+  for (k = m; --k >= 0; ) {     /* delete the generation data */
+    free(gds[k].rec); if (k > 0) free(gds[k].map); }
+  free(gds);                    /* (records and private buffers) */
+  if (ist->htree) {             /* delete the hash tree */
+    ht_delete(ist->htree); ist->htree = NULL; }  /* of the old level */
   if (!ist->lvls[ist->height])  /* if no child has been added, */
     return 1;                   /* abort the function, otherwise */
   ist->height++;                /* increment the level counter */
-  _checksub(ist->lvls[0]);      /* check for unnecessary subtrees */
-  return 0;                     /* return 'ok' */
+  ist->ucnt = (mode == AL_OPTIM) ? ist->ucnt+1 : 1;
+  _checksub(ist->lvls[0], ist->height -ist->ucnt);
+  if ((ist->mode & IST_HASH) && (mode < AL_PAIRS)
+  &&  (_htbuild(ist) != 0))     /* note the uncounted levels, */
+    return -1;                  /* check for unnecessary subtrees */
+  return 0;                     /* and build a hash tree if requested */
+}  /* _addlvl() */
+
+/*--------------------------------------------------------------------*/
+
+static int _trialloc (ISTREE *ist, int n)
+{                               /* --- allocate a triangular array */
+  int    i;                     /* loop variable */
+  size_t k;                     /* offset of a row */
+
+  assert(ist && !ist->tri && (n >= 2));
+  ist->tofs = (size_t*)malloc(n *sizeof(size_t) +n *sizeof(int));
+  if (!ist->tofs) return -1;    /* create the row offsets */
+  ist->tri = calloc((size_t)n *(size_t)(n-1) /2, ist->cwd);
+  if (!ist->tri) { free(ist->tofs); ist->tofs = NULL; return -1; }
+  for (k = 0, i = 0; i < n; i++) {
+    ist->tofs[i] = k; k += (size_t)(n-1-i); }
+  ist->tcnt = n;                /* the rows follow each other */
+  return 0;                     /* (a t.a. buffer follows the offsets) */
+}  /* _trialloc() */
+
+/*--------------------------------------------------------------------*/
+
+static int _tricreate (ISTREE *ist)
+{                               /* --- create a triangular array */
+  int    i, n, id;              /* loop variable, number of items */
+
+  assert(ist && !ist->tri && (ist->height == 1));
+  n = is_cnt(ist->set);         /* get the number of items */
+  if ((n < 2) || ((double)n *(n-1) /2 *ist->cwd > TR_MAXSIZE))
+    return 1;                   /* check the size of the array */
+  for (i = 0; i < n; i++)       /* check for a candidate pair */
+    if (_child(ist, ist->lvls[0], i, ist->supp, ist->rule,
+               ist->buf +ist->vsz, ist->map, &id) > 0) break;
+  if (i >= n) return 1;         /* if there is none, abort */
+  if (_trialloc(ist, n) != 0)   /* create a triangular array */
+    return -1;                  /* for all items */
+  ist->lvls[1] = NULL;          /* there are no nodes */
+  ist->arns[1] = NULL;          /* on the second level yet, */
+  ist->height  = 2;             /* the second level is represented */
+  ist->ucnt    = 1;             /* by the triangular array */
+  return 0;                     /* until it has been counted */
+}  /* _tricreate() */
+
+/*--------------------------------------------------------------------*/
+
+static int _trilvl (ISTREE *ist)
+{                               /* --- create second level from pairs */
+  int r;                        /* result of level creation */
+
+  assert(ist && ist->tri && (ist->height == 2));
+  ist->height = 1;              /* create the second level with */
+  r = _addlvl(ist, AL_PAIRS);   /* the frequent pairs and if there */
+  if (r > 0)                    /* is none, with all candidate pairs */
+    r = _addlvl(ist, AL_ALLPRS);/* (so that the tree height is kept) */
+  if (r < 0) { ist->height = 2; return -1; }
+  free(ist->tri);  ist->tri  = NULL;
+  free(ist->tofs); ist->tofs = NULL;
+  return r;                     /* delete the triangular array */
+}  /* _trilvl() */              /* and return the result */
+
+/*--------------------------------------------------------------------*/
+
+int ist_addlvl (ISTREE *ist)
+{                               /* --- add a level to item set tree */
+  assert(ist);                  /* check the function argument */
+  if (ist->ucnt > 1) _prune(ist);  /* prune optimistic levels */
+  if (ist->tri && (_trilvl(ist) < 0))
+    return -1;                  /* create the second level */
+  if ((ist->mode & IST_PAIRS) && (ist->height == 1)
+  &&  (_tricreate(ist) == 0))   /* count the pairs of items */
+    return 0;                   /* in a triangular array */
+  return _addlvl(ist, AL_COUNTS);  /* add a level from the counts */
 }  /* ist_addlvl() */
 
 /*--------------------------------------------------------------------*/
 
+int ist_addopt (ISTREE *ist)
+{                               /* --- add an optimistic level */
+  assert(ist);                  /* check the function argument */
+  if ((ist->height < 3)         /* the second level must have */
+  ||  ist->tri) return 1;       /* been counted (else all subsets */
+                                /* of the items are candidates) */
+  return _addlvl(ist, AL_OPTIM);/* add a level without counts */
+}  /* ist_addopt() */
+
+/*--------------------------------------------------------------------*/
+
+int ist_pairs (ISTREE *ist)
+{                               /* --- set pair counters from item set */
+  int      i, k, n;             /* loop variables, number of items */
+  ISNODE   *node;               /* to traverse the nodes */
+  ITEMPAIR *p;                  /* to traverse the item pairs */
+  size_t   x;                   /* index in triangular array */
+
+  assert(ist);                  /* check the function argument */
+  if (!ist->set->pairs || !ist->set->pfix || (ist->height != 2))
+    return 1;                   /* check for recoded pair counters */
+  if (ist->tri) {               /* if there is a triangular array */
+    n = ist->tcnt;              /* get the number of items */
+    for (p = ist->set->pairs, i = ist->set->psz; --i >= 0; p++) {
+      if ((p->a < 0) || (p->b >= n)) continue;
+      x = ist->tofs[p->a] +(size_t)(p->b -p->a -1);
+      if      (ist->cwd == 2) ((SCNT*)ist->tri)[x] = (SCNT)p->frq;
+      else if (ist->cwd == 4) ((int*) ist->tri)[x] = (int) p->frq;
+      else                    ((LCNT*)ist->tri)[x] = (LCNT)p->frq;
+    }                           /* copy the pair frequencies */
+    return 0;                   /* to the triangular array */
+  }                             /* and abort the function */
+  n = is_cnt(ist->set);         /* get the number of items */
+  for (node = ist->lvls[1]; node; node = node->succ) {
+    for (i = 0; i < node->size; i++) {
+      k = (node->offset >= 0) ? node->offset +i : MAP(node, ist->cwd)[i];
+      if (k < n) _setcnt(node, i, ist->cwd,
+                         is_getpfq(ist->set, ID(node), k));
+    }                           /* traverse the nodes of the second */
+  }                             /* level and set their counters */
+  return 0;                     /* return 'ok' */
+}  /* ist_pairs() */
+
+/*--------------------------------------------------------------------*/
+
+void ist_fill (ISTREE *ist, ISSUPPFN *getsupp, void *data)
+{                               /* --- set counters of deepest level */
+  int    i, k, h, n;            /* loop variables, number of items */
+  int    *set;                  /* item set of a counter */
+  ISNODE *node, *p;             /* to traverse the nodes */
+  size_t x;                     /* index in triangular array */
+
+  assert(ist && getsupp);       /* check the function arguments */
+  set = ist->buf;               /* get the path buffer */
+  if (ist->tri) {               /* if there is a triangular array */
+    for (x = 0, i = 0; i < ist->tcnt; i++) {
+      for (set[0] = i, k = i+1; k < ist->tcnt; k++, x++) {
+        set[1] = k;             /* traverse the item pairs */
+        if      (ist->cwd == 2) ((SCNT*)ist->tri)[x] =
+                                  (SCNT)getsupp(set, 2, data);
+        else if (ist->cwd == 4) ((int*) ist->tri)[x] =
+                                  (int) getsupp(set, 2, data);
+        else                    ((LCNT*)ist->tri)[x] =
+                                  (LCNT)getsupp(set, 2, data);
+      }                         /* set the pair counters */
+    }                           /* in the triangular array */
+    return;                     /* (the rows follow each other) */
+  }
+  h = ist->height;              /* get the size of the item sets */
+  if (h < 2) return;            /* (the root is counted in reading) */
+  n = is_cnt(ist->set);         /* and the number of items */
+  for (node = ist->lvls[h-1]; node; node = node->succ) {
+    for (i = h-1, p = node; p->parent; p = p->parent)
+      set[--i] = ID(p);         /* collect the items on the path */
+    for (i = 0; i < node->size; i++) {
+      k = (node->offset >= 0) ? node->offset +i : MAP(node, ist->cwd)[i];
+      set[h-1] = k;             /* add the item of the counter */
+      _setcnt(node, i, ist->cwd, (k < n) ? getsupp(set, h, data) : 0);
+    }                           /* traverse the nodes of the deepest */
+  }                             /* level and set their counters */
+}  /* ist_fill() */
+
+/*--------------------------------------------------------------------*/
+
+int ist_recode (ISTREE *ist, char *marks, int *map)
+{                               /* --- recode the used items */
+  int    i, k, m, n;            /* loop variables, numbers of items */
+  int    a, b;                  /* new codes of the items of a pair */
+  ISNODE *root, *node;          /* root node, to traverse the nodes */
+  void   *cnts;                 /* buffer for the root counters */
+  size_t x;                     /* index in triangular array */
+  SUPP   c;                     /* support of an item pair */
+
+  assert(ist && marks && map);  /* check the function arguments */
+  if (ist->ucnt > 1) _prune(ist);  /* prune optimistic levels */
+  if (ist->tri && (_trilvl(ist) < 0))
+    return -1;                  /* create the second level */
+  if (ist->height != 2)         /* items can only be reordered */
+    return 0;                   /* if all levels >= 2 are rebuilt */
+  n = is_cnt(ist->set);         /* get the number of items */
+  for (m = i = 0; i < n; i++)   /* map the used items to the front */
+    if (marks[i]) map[i] = m++; /* (keep their relative order) */
+  for (k = m, i = 0; i < n; i++)
+    if (!marks[i]) map[i] = k++;/* map the unused items to the end */
+  if ((m < 2) || (m >= n)       /* check the number of used items */
+  ||  ((double)m *(m-1) /2 *ist->cwd > TR_MAXSIZE))
+    return 0;                   /* and the size of the array */
+  root = ist->lvls[0];          /* get the root node */
+  cnts = malloc((size_t)n *ist->cwd);
+  if (!cnts) return -1;         /* create a counter buffer */
+  if (_trialloc(ist, m) != 0) { free(cnts); return -1; }
+
+  /* --- collect the pair counters --- */
+  for (node = ist->lvls[1]; node; node = node->succ) {
+    if (!marks[ID(node)]) continue;
+    a = map[ID(node)];          /* traverse the nodes of used items */
+    for (i = 0; i < node->size; i++) {
+      k = (node->offset >= 0) ? node->offset +i : MAP(node, ist->cwd)[i];
+      if ((k >= n) || !marks[k]) continue;
+      b = map[k];               /* traverse the used items */
+      c = COUNT(_getcnt(node, i, ist->cwd));
+      x = ist->tofs[a] +(size_t)(b -a -1);
+      if      (ist->cwd == 2) ((SCNT*)ist->tri)[x] = (SCNT)c;
+      else if (ist->cwd == 4) ((int*) ist->tri)[x] = (int) c;
+      else                    ((LCNT*)ist->tri)[x] = (LCNT)c;
+    }                           /* copy the pair counters */
+  }                             /* to the triangular array */
+
+  /* --- recode the items --- */
+  is_remap(ist->set, map);      /* recode the underlying item set */
+  memcpy(cnts, root->cnts, (size_t)n *ist->cwd);
+  for (i = n; --i >= 0; ) {     /* permute the root counters */
+    k = map[i];                 /* (all counters are moved, */
+    if      (ist->cwd == 2) ((SCNT*)root->cnts)[k] = ((SCNT*)cnts)[i];
+    else if (ist->cwd == 4) ((int*) root->cnts)[k] = ((int*) cnts)[i];
+    else                    ((LCNT*)root->cnts)[k] = ((LCNT*)cnts)[i];
+  }                             /* so the skip flags are kept) */
+  free(cnts);                   /* delete the counter buffer */
+  for (i = n; --i >= 0; )       /* recode the item markers */
+    marks[i] = (char)(i < m);   /* (used items are now at the front) */
+  for (i = 0; i < 2; i++)       /* recode the group labels */
+    if (ist->grps[i] >= 0) ist->grps[i] = map[ist->grps[i]];
+  if (ist->htree) {             /* delete the hash tree */
+    ht_delete(ist->htree); ist->htree = NULL; }
+  free(ist->arns[1]);           /* delete the second level */
+  ist->arns[1] = ist->lvls[1] = NULL;
+  root->chvec  = NULL;          /* and clear the child vector */
+  root->chcnt  = 0;             /* of the root node */
+  ist->ucnt    = 1;             /* rebuild the second level */
+  return (_trilvl(ist) < 0) ? -1 : m;
+}  /* ist_recode() */           /* from the triangular array */
+
+/*--------------------------------------------------------------------*/
+
 void ist_up (ISTREE *ist, int root)
 {                               /* --- go up in item set tree */
   assert(ist && ist->curr);     /* check the function argument */
@@ -861,15 +2252,15 @@ int ist_down (ISTREE *ist, int item)
   c = node->chcnt & ~F_SKIP;    /* if there are no child nodes, */
   if (c <= 0) return -1;        /* abort the function */
   if (node->offset >= 0) {      /* if a pure vector is used */
-    vec = (ISNODE**)(node->cnts +node->size);
+    vec = node->chvec;
     item -= ID(vec[0]);         /* compute index in child node vector */
     if (item >= c) return -1; } /* and abort if there is no child */
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    vec = (ISNODE**)(map +n);   /* get id. map and child vector */
+    map = MAP(node, ist->cwd); n = node->size;
+    vec = node->chvec;          /* get the child vector */
     if (c < n)                  /* if a secondary id. map exists, */
       map = (int*)(vec +(n = c));      /* get this identifier map */
-    item = _bsearch(map, n, item);
+    item = _search(node, map, n, item);
   }                             /* search for the proper index */
   if ((item < 0) || !vec[item]) /* if the index is out of range */
     return -1;                  /* or the child does not exist, abort */
@@ -892,10 +2283,10 @@ int ist_next (ISTREE *ist, int item)
     if (item >= node->offset +node->size) return -1;
     return item +1; }           /* return the next item identifier */
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
+    map = MAP(node, ist->cwd); n = node->size;
     if (item <  map[0])   return map[0];
     if (item >= map[n-1]) return -1;
-    i = _bsearch(map, n, item); /* try to find the item directly */
+    i = _search(node, map, n, item);   /* try to find the item */
     if (i >= 0) return map[i+1];/* and return the following one */
     while ((--n >= 0) && (*map > item)) map++;
     return (n >= 0) ? *map :-1; /* search iteratively for the next */
@@ -904,7 +2295,7 @@ int ist_next (ISTREE *ist, int item)
 
 /*--------------------------------------------------------------------*/
 
-void ist_setcnt (ISTREE *ist, int item, int cnt)
+void ist_setcnt (ISTREE *ist, int item, SUPP cnt)
 {                               /* --- set counter for an item */
   ISNODE *node;                 /* the current node */
   ISNODE **vec;                 /* child node vector of current node */
@@ -917,19 +2308,19 @@ void ist_setcnt (ISTREE *ist, int item, int cnt)
     item -= node->offset;       /* get index in counter vector */
     if (item >= node->size) return; }
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    vec = (ISNODE**)(map +n);   /* get id. map and child vector */
+    map = MAP(node, ist->cwd); n = node->size;
+    vec = node->chvec;          /* get the child vector */
     c = node->chcnt & ~F_SKIP;  /* and the number of children */
     if (c < n)                  /* if a secondary id. map exists, */
       map = (int*)(vec +(n = c));      /* get this identifier map */
-    item = _bsearch(map, n, item);
+    item = _search(node, map, n, item);
   }                             /* search for the proper index */
-  if (item >= 0) node->cnts[item] = cnt;
+  if (item >= 0) _setcnt(node, item, ist->cwd, cnt);
 }  /* ist_setcnt() */           /* set the frequency counter */
 
 /*--------------------------------------------------------------------*/
 
-int ist_getcnt (ISTREE *ist, int item)
+SUPP ist_getcnt (ISTREE *ist, int item)
 {                               /* --- get counter for an item */
   ISNODE *node;                 /* the current node */
   ISNODE **vec;                 /* child node vector of current node */
@@ -942,63 +2333,79 @@ int ist_getcnt (ISTREE *ist, int item)
     item -= node->offset;       /* get index in counter vector */
     if (item >= node->size) return -1; }
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    vec = (ISNODE**)(map +n);   /* get id. map and child vector */
+    map = MAP(node, ist->cwd); n = node->size;
+    vec = node->chvec;          /* get the child vector */
     c = node->chcnt & ~F_SKIP;  /* and the number of children */
     if (c < n)                  /* if a secondary id. map exists, */
       map = (int*)(vec +(n = c));      /* get this identifier map */
-    item = _bsearch(map, n, item);
+    item = _search(node, map, n, item);
   }                             /* search for the proper index */
   if (item < 0) return -1;      /* abort if index is out of range */
-  return node->cnts[item];      /* return the value of the counter */
-}  /* ist_getcnt() */
+  return _getcnt(node, item, ist->cwd);
+}  /* ist_getcnt() */           /* return the value of the counter */
 
 /*--------------------------------------------------------------------*/
 
-int ist_getcntx (ISTREE *ist, int *set, int cnt)
+SUPP ist_getcntx (ISTREE *ist, int *set, int cnt)
 {                               /* --- get counter for an item set */
   assert(ist                    /* check the function arguments */
      && (cnt >= 0) && (set || (cnt <= 0)));
   if (cnt <= 0)                 /* if the item set is empty, */
     return ist->tacnt;          /* return the transaction count */
-  return COUNT(_getsupp(ist->lvls[0], set, cnt));
+  return COUNT(_getsupp(ist->lvls[0], set, cnt, ist->cwd));
 }  /* ist_getcntx() */          /* return the item set support */
 
 /*--------------------------------------------------------------------*/
 
-void ist_filter (ISTREE *ist, int mode)
+int ist_filter (ISTREE *ist, int mode)
 {                               /* --- filter frequent item sets */
   int    i, k;                  /* loop variables */
+  int    item, app;             /* item identifier, appearance flag */
   ISNODE *node;                 /* to traverse the nodes */
-  int    supp;                  /* support of an item set */
+  SUPP   supp;                  /* support of an item set */
 
   assert(ist);                  /* check the function argument */
+  if (ist->ucnt > 1) _prune(ist);  /* prune optimistic levels */
+  if (ist->tri && (_trilvl(ist) < 0))
+    return -1;                  /* create the second level */
   if (mode == IST_CLEAR) {      /* if to clear all skip flags */
     for (k = 1; k < ist->height; k++)
       for (node = ist->lvls[k]; node; node = node->succ)
         for (i = 0; i < node->size; i++)
-          node->cnts[i] &= ~F_SKIP;
-    return;                     /* clear all skip flags */
+          CLRSKIP(node, i, ist->cwd);
+    return 0;                   /* clear all skip flags */
   }                             /* and abort the function */
   supp = -1;                    /* set default support filter */
   for (k = 1; k < ist->height; k++) {
     for (node = ist->lvls[k]; node; node = node->succ) {
       for (i = 0; i < node->size; i++) {
-        if (node->cnts[i] < ist->supp)
-          continue;             /* skip infrequent item sets */
-        if (mode == IST_CLOSED) supp = node->cnts[i];
+        if (node->offset >= 0) item = node->offset +i;
+        else                   item = MAP(node, ist->cwd)[i];
+        app = is_getapp(ist->set, item);
+        if ((app == IST_IGNORE) || (HDONLY(node) && (app == IST_HEAD))
+        ||  (_getcnt(node, i, ist->cwd) < ist->supp))
+          continue;             /* skip padding counters (sets that */
+                                /* are not in the search space) and */
+                                /* infrequent item sets */
+        if (mode == IST_CLOSED) supp = _getcnt(node, i, ist->cwd);
         _marksub(ist, node, i, supp);
       }                         /* mark all n-1 subsets */
     }                           /* of the current item set */
   }                             /* that have to be cleared/marked */
+  return 0;                     /* return 'ok' */
 }  /* ist_filter() */
 
 /*--------------------------------------------------------------------*/
 
-void ist_init (ISTREE *ist, int minlen, int arem, double minval)
+int ist_init (ISTREE *ist, int minlen, int arem, double minval)
 {                               /* --- initialize (rule) extraction */
+  int i, k, n;                  /* loop variables, number of items */
+
   assert(ist                    /* check the function arguments */
       && (minlen > 0) && (minval >= 0.0) && (minval <= 1.0));
+  if (ist->ucnt > 1) _prune(ist);  /* prune optimistic levels */
+  if (ist->tri && (_trilvl(ist) < 0))
+    return -1;                  /* create the second level */
   ist->item = ist->index = -1;  /* initialize rule extraction */
   ist->node = ist->lvls[minlen -1];
   ist->size = minlen;
@@ -1007,18 +2414,30 @@ void ist_init (ISTREE *ist, int minlen, int arem, double minval)
     arem = EM_NONE;             /* check, adapt, and note */
   ist->arem   = arem;           /* additional evaluation measure */
   ist->minval = minval;         /* and its minimal value */
+  if (ist->mode & IST_CONTR) {  /* if to find contrast sets, */
+    n = is_cnt(ist->set);       /* find the group labels */
+    if (n > ist->lvls[0]->size) n = ist->lvls[0]->size;
+    for (k = i = 0; i < n; i++){/* (the two head only items, */
+      if (is_getapp(ist->set, i) != IST_HEAD) continue;
+      if (k < 2) ist->grps[k] = i;
+      k++;                      /* with the label of group 1 */
+    }                           /* coded before that of group 2) */
+    if (k != 2) return -1;      /* check for exactly two labels */
+  }
+  return 0;                     /* return 'ok' */
 }  /* ist_init() */
 
 /*--------------------------------------------------------------------*/
 
-int ist_set (ISTREE *ist, int *set, int *supp, double *aval)
+int ist_set (ISTREE *ist, int *set, SUPP *supp, double *aval)
 {                               /* --- extract next frequent item set */
   int    i;                     /* loop variable */
   int    item;                  /* an item identifier */
   ISNODE *node, *tmp;           /* current item set node, buffer */
-  int    *cnts;                 /* to access the item frequencies */
-  int    s_set;                 /* support of the current set */
+  ISNODE *root;                 /* to access the item frequencies */
+  SUPP   s_set;                 /* support of the current set */
   double dev;                   /* deviation from indep. occurrence */
+  int    app;                   /* appearance flag of an item */
 
   assert(ist && set && supp);   /* check the function arguments */
   if (ist->size > ist->height)  /* if the tree is not high enough */
@@ -1038,21 +2457,22 @@ int ist_set (ISTREE *ist, int *set, int *supp, double *aval)
       ist->index = 0;           /* start with the first item set */
     }                           /* of the new item set node */
     if (node->offset >= 0) item = node->offset +ist->index;
-    else                   item = node->cnts[node->size +ist->index];
-    if (is_getapp(ist->set, item) == IST_IGNORE)
-      continue;                 /* skip items to ignore */
-    s_set = node->cnts[ist->index];
-    if (s_set < ist->supp)      /* if the support is not sufficient, */
-      continue;                 /* go to the next item set */
+    else                   item = MAP(node, ist->cwd)[ist->index];
+    app = is_getapp(ist->set, item);
+    if ((app == IST_IGNORE) || (HDONLY(node) && (app == IST_HEAD)))
+      continue;                 /* skip items to ignore and sets with */
+    s_set = _getcnt(node, ist->index, ist->cwd);  /* two head only */
+    if (s_set < ist->supp)      /* items (padding counters of pure */
+      continue;                 /* vectors), check the support */
     /* Note that this check automatically skips all item sets that */
-    /* are marked with the flag F_SKIP, because s_set is negative  */
+    /* are marked with the flag F_CSKIP, because s_set is negative */
     /* with this flag and thus necessarily smaller than ist->supp. */
     dev = 0;                    /* init. add. evaluation measure */
     if (ist->arem == EM_DIFF) { /* if logarithm of support quotient */
-      cnts = ist->lvls[0]->cnts;
-      dev  = log(s_set) -log(COUNT(cnts[item]));
+      root = ist->lvls[0];      /* get the root with the frequencies */
+      dev  = log(s_set) -log(COUNT(_getcnt(root, item, ist->cwd)));
       for (tmp = node; tmp->parent; tmp = tmp->parent)
-        dev -= log(COUNT(cnts[ID(tmp)]));
+        dev -= log(COUNT(_getcnt(root, ID(tmp), ist->cwd)));
       dev = (dev +(ist->size-1) *log(ist->tacnt)) *(0.01/LN_2);
       if (dev < ist->minval)    /* if the value of the additional */
         continue;               /* eval. measure is not high enough, */
@@ -1074,17 +2494,74 @@ int ist_set (ISTREE *ist, int *set, int *supp, double *aval)
 
 /*--------------------------------------------------------------------*/
 
+int ist_cset (ISTREE *ist, int *set, SUPP *supp, double *aval)
+{                               /* --- extract next contrast set */
+  int    i, k;                  /* loop variable, item set size */
+  int    item;                  /* an item identifier */
+  ISNODE *node;                 /* current item set node */
+  SUPP   s_set;                 /* support of the current set */
+  SUPP   n1, n2;                /* sizes of the two groups */
+  double v = 0;                 /* value of the additional measure */
+
+  assert(ist && (ist->mode & IST_CONTR) && set && supp);
+  node = ist->node;             /* get the current item set node */
+  while (1) {                   /* search for a contrast set */
+    if (ist->size >= ist->height)
+      return -1;                /* the group supports must be counted */
+    if (++ist->index >= node->size) { /* if all subsets have been */
+      node = node->succ;        /* processed, go to the successor */
+      if (!node) {              /* if at the end of a level, go down */
+        if (++ist->size >= ist->height)
+          return -1;            /* if at the deepest level, abort */
+        node = ist->lvls[ist->size -1];
+      }                         /* get the 1st node of the new level */
+      ist->node  = node;        /* note the new item set node */
+      ist->index = 0;           /* start with the first item set */
+    }                           /* of the new item set node */
+    if (HDONLY(node)) continue; /* skip sets with a group label */
+    if (node->offset >= 0) item = node->offset +ist->index;
+    else                   item = MAP(node, ist->cwd)[ist->index];
+    if (is_getapp(ist->set, item) != IST_BODY)
+      continue;                 /* skip labels and items to ignore */
+    s_set = _getcnt(node, ist->index, ist->cwd);
+    if (s_set < ist->supp)      /* if the support is not sufficient, */
+      continue;                 /* go to the next item set */
+    k = ist->size;              /* build the body set */
+    set[--k] = item;            /* (the group labels follow it) */
+    for (i = k; node->parent; node = node->parent) set[--i] = ID(node);
+    node = ist->node;           /* get the group supports */
+    set[k+1] = ist->grps[0]; supp[0] = _getsupp(ist->lvls[0], set, k+2,
+                                                ist->cwd);
+    set[k+1] = ist->grps[1]; supp[1] = _getsupp(ist->lvls[0], set, k+2,
+                                                ist->cwd);
+    if ((supp[0] < 0) || (supp[1] < 0))
+      continue;                 /* both supports must be known */
+    if (ist->arem != EM_NONE) { /* if an add. measure is given */
+      n1 = COUNT(_getcnt(ist->lvls[0], ist->grps[0], ist->cwd));
+      n2 = COUNT(_getcnt(ist->lvls[0], ist->grps[1], ist->cwd));
+      v  = _evalfns[ist->arem](supp[1], supp[0]+supp[1], n2, n1+n2);
+      if (v < ist->minval)      /* evaluate the contrast set and */
+        continue;               /* skip it if the value is too low */
+    }                           /* (group 2 is treated as the head */
+    break;                      /* of a rule with the set as body) */
+  }
+  if (aval) *aval = v;          /* store the measure value */
+  return ist->size;             /* return the item set size */
+}  /* ist_cset() */
+
+/*--------------------------------------------------------------------*/
+
 int ist_rule (ISTREE *ist, int *rule,
-              int *supp, double *conf, double *lift, double *aval)
+              SUPP *supp, double *conf, double *lift, double *aval)
 {                               /* --- extract next rule */
   int    i;                     /* loop variable */
   int    item;                  /* an item identifier */
   ISNODE *node;                 /* current item set node */
   ISNODE *parent;               /* parent of the item set node */
   int    *map, n;               /* identifier map and its size */
-  int    s_set;                 /* support of set  (body & head) */
-  int    s_body;                /* support of body (antecedent) */
-  int    s_head;                /* support of head (consequent) */
+  SUPP   s_set;                 /* support of set  (body & head) */
+  SUPP   s_body;                /* support of body (antecedent) */
+  SUPP   s_head;                /* support of head (consequent) */
   double c, v;                  /* confidence and measure value */
   int    app;                   /* appearance flag of head item */
 
@@ -1115,7 +2592,7 @@ int ist_rule (ISTREE *ist, int *rule,
         ist->index  = 0;        /* start with the first item set */
       }                         /* of the new item set node */
       if (node->offset >= 0) item = node->offset +ist->index;
-      else                   item = node->cnts[node->size +ist->index];
+      else                   item = MAP(node, ist->cwd)[ist->index];
       app = is_getapp(ist->set, item);
       if ((app == IST_IGNORE) || (HDONLY(node) && (app == IST_HEAD)))
         continue;               /* skip sets with two head only items */
@@ -1128,26 +2605,28 @@ int ist_rule (ISTREE *ist, int *rule,
     app = is_getapp(ist->set, ist->item); /* get head item appearance */
     if (!(app & IST_HEAD) || (ist->hdonly && (app != IST_HEAD)))
       continue;                 /* if rule is not allowed, skip it */
-    s_set = COUNT(node->cnts[ist->index]);
+    s_set = COUNT(_getcnt(node, ist->index, ist->cwd));
     if (s_set < ist->supp) {    /* get and check the item set support */
       ist->item = -1; continue; }
     parent = node->parent;      /* get the parent node */
     if (ist->plen > 0)          /* if there is a path, use it */
-      s_body = COUNT(_getsupp(ist->head, ist->path, ist->plen));
+      s_body = COUNT(_getsupp(ist->head, ist->path, ist->plen,
+                              ist->cwd));
     else if (!parent)           /* if there is no parent (root node), */
       s_body = ist->tacnt;      /* get the number of transactions */
     else if (parent->offset >= 0)  /* if a pure vector is used */
-      s_body = COUNT(parent->cnts[ID(node) -parent->offset]);
+      s_body = COUNT(_getcnt(parent, ID(node) -parent->offset, ist->cwd));
     else {                      /* if an identifier map is used */
-      map = parent->cnts +(n = parent->size);
-      s_body = COUNT(parent->cnts[_bsearch(map, n, ID(node))]);
+      map = MAP(parent, ist->cwd); n = parent->size;
+      i = _search(parent, map, n, ID(node));
+      s_body = COUNT(_getcnt(parent, i, ist->cwd));
     }                           /* find vector index and get support */
     if (s_body < ist->rule)     /* if the body support is too low, */
       continue;                 /* get the next subset/next set */
     c = s_set/(double)s_body;   /* compute the rule confidence */
     if (c < ist->conf -EPSILON) /* if the confidence is too low, */
       continue;                 /* go to the next item (sub)set */
-    s_head = COUNT(ist->lvls[0]->cnts[ist->item]);
+    s_head = COUNT(_getcnt(ist->lvls[0], ist->item, ist->cwd));
     if (ist->arem == EM_NONE) { /* if no add. eval. measure given, */
       v = 0; break; }           /* abort the loop (select the rule) */
     if (ist->size < 2) {        /* if rule has an empty antecedent, */
@@ -1164,7 +2643,7 @@ int ist_rule (ISTREE *ist, int *rule,
 
   /* --- build rule --- */
   if (node->offset >= 0) item = node->offset +ist->index;
-  else                   item = node->cnts[node->size +ist->index];
+  else                   item = MAP(node, ist->cwd)[ist->index];
   i = ist->size;                /* get the current item and */
   if (item != ist->item)        /* if this item is not the head, */
     rule[--i] = item;           /* add it to the rule body */
@@ -1180,7 +2659,7 @@ int ist_rule (ISTREE *ist, int *rule,
 /*--------------------------------------------------------------------*/
 
 int ist_hedge (ISTREE *ist, int *hedge,
-               int *supp, double *conf, double *aval)
+               SUPP *supp, double *conf, double *aval)
 {                               /* --- extract next hyperedge */
   int    i;                     /* loop variable */
   int    item;                  /* an item identifier */
@@ -1188,9 +2667,9 @@ int ist_hedge (ISTREE *ist, int *hedge,
   ISNODE *head;                 /* node containing the rule head */
   int    *map, n;               /* identifier map and its size */
   int    *path, plen;           /* path in tree and its length */
-  int    s_set;                 /* support of set (body & head) */
-  int    s_body;                /* support of body (antecedent) */
-  int    s_head;                /* support of head (consequent) */
+  SUPP   s_set;                 /* support of set (body & head) */
+  SUPP   s_body;                /* support of body (antecedent) */
+  SUPP   s_head;                /* support of head (consequent) */
   double c, t, v = 0;           /* confidence and measure value */
 
   assert(ist && hedge && supp); /* check the function arguments */
@@ -1211,39 +2690,39 @@ int ist_hedge (ISTREE *ist, int *hedge,
       ist->index = 0;           /* start with the first item set */
     }                           /* of the new item set node */
     if (node->offset >= 0) item = node->offset +ist->index;
-    else                   item = node->cnts[node->size +ist->index];
+    else                   item = MAP(node, ist->cwd)[ist->index];
     if (is_getapp(ist->set, item) == IST_IGNORE)
       continue;                 /* skip items to ignore */
-    s_set = COUNT(node->cnts[ist->index]);
+    s_set = COUNT(_getcnt(node, ist->index, ist->cwd));
     if (s_set < ist->supp)      /* if the set support is too low, */
       continue;                 /* skip this item set */
     head = node->parent;        /* get subset support from parent */
     if (!head)                  /* if there is no parent (root node), */
       s_body = ist->tacnt;      /* get the total number of sets */
     else if (head->offset >= 0) /* if pure vectors are used */
-      s_body = head->cnts[ID(node) -head->offset];
+      s_body = _getcnt(head, ID(node) -head->offset, ist->cwd);
     else {                      /* if an identifier map is used */
-      map = head->cnts +(n = head->size);
-      s_body = head->cnts[_bsearch(map, n, ID(node))];
+      map = MAP(head, ist->cwd); n = head->size;
+      s_body = _getcnt(head, _search(head, map, n, ID(node)), ist->cwd);
     }                           /* find index and get the support */
-    if (s_body & F_SKIP) {      /* check for a valid body */
-      node->cnts[ist->index] |= F_SKIP; continue; }
+    if (s_body & F_CSKIP) {     /* check for a valid body */
+      SKIPCNT(node, ist->index, ist->cwd); continue; }
     s_body = COUNT(s_body);     /* get the support of body and head */
-    s_head = COUNT(ist->lvls[0]->cnts[item]);
+    s_head = COUNT(_getcnt(ist->lvls[0], item, ist->cwd));
     c = s_set/(double)s_body;   /* compute confidence and add. eval. */
     v = _evalfns[ist->arem](s_set, s_body, s_head, ist->tacnt);
+    plen = 1;                   /* initialize the path */
+    path = ist->buf +ist->vsz;  /* (store first item, which also */
+    *--path = item;             /* works with an identifier map) */
     item = ID(node);            /* note the next head item */
-    plen = 1;                   /* and initialize the path */
-    path = ist->buf +ist->vsz;  /* (store first item) */
-    *--path = ist->index +node->offset;
     while (head) {              /* traverse the path up to root */
-      s_body = _getsupp(head, path, plen);
-      if (s_body & F_SKIP) break;
+      s_body = _getsupp(head, path, plen, ist->cwd);
+      if (s_body & F_CSKIP) break;
       s_body = COUNT(s_body);   /* get the support of the body */
       *--path = item; plen++;   /* store the previous head item */
       item = ID(head);          /* in the path (extend path) */
       c += s_set/(double)s_body;/* sum the rule confidences */
-      s_head = COUNT(ist->lvls[0]->cnts[item]);
+      s_head = COUNT(_getcnt(ist->lvls[0], item, ist->cwd));
       t = _evalfns[ist->arem](s_set, s_body, s_head, ist->tacnt);
       if (t < v) v = t;         /* compute the add. evaluation */
       head = head->parent;      /* and go to the parent node */
@@ -1254,7 +2733,7 @@ int ist_hedge (ISTREE *ist, int *hedge,
     &&  (v > fabs(ist->minval) -EPSILON))
       break;                    /* check whether hyperedge qualifies */
     if ((ist->minval < 0) && node->parent)
-      node->cnts[ist->index] |= F_SKIP;
+      SKIPCNT(node, ist->index, ist->cwd);
   }  /* while (1) */            /* otherwise mark it as skipped */
   *supp = s_set;                /* store the hyperedge support, */
   if (conf) *conf = c;          /* the average confidence and */
@@ -1263,7 +2742,7 @@ int ist_hedge (ISTREE *ist, int *hedge,
   /* --- build hyperedge --- */
   i = ist->size -1;             /* store the first item */
   if (node->offset >= 0) hedge[i] = ist->index +node->offset;
-  else                   hedge[i] = node->cnts[node->size +ist->index];
+  else                   hedge[i] = MAP(node, ist->cwd)[ist->index];
   while (node->parent) {        /* while not at the root node */
     hedge[--i] = ID(node);      /* add item to the hyperedge */
     node = node->parent;        /* and go to the parent node */
@@ -1273,7 +2752,7 @@ int ist_hedge (ISTREE *ist, int *hedge,
 
 /*--------------------------------------------------------------------*/
 
-int ist_group (ISTREE *ist, int *group, int *supp, double *aval)
+int ist_group (ISTREE *ist, int *group, SUPP *supp, double *aval)
 {                               /* --- extract next group */
   int    i;                     /* loop variable */
   int    item;                  /* an item identifier */
@@ -1281,9 +2760,9 @@ int ist_group (ISTREE *ist, int *group, int *supp, double *aval)
   ISNODE *head;                 /* node containing the rule head */
   int    *map, n;               /* identifier map and its size */
   int    *path, plen;           /* path in tree and its length */
-  int    s_set;                 /* support of set (body & head) */
-  int    s_body;                /* support of body (antecedent) */
-  int    s_head;                /* support of head (consequent) */
+  SUPP   s_set;                 /* support of set (body & head) */
+  SUPP   s_body;                /* support of body (antecedent) */
+  SUPP   s_head;                /* support of head (consequent) */
   double t, v = 0;              /* additional measure value */
 
   assert(ist && group && supp); /* check the function arguments */
@@ -1308,38 +2787,41 @@ int ist_group (ISTREE *ist, int *group, int *supp, double *aval)
       ist->index = 0;           /* start with the first item set */
     }                           /* of the new item set node */
     if (node->offset >= 0) item = node->offset +ist->index;
-    else                   item = node->cnts[node->size +ist->index];
+    else                   item = MAP(node, ist->cwd)[ist->index];
     if (is_getapp(ist->set, item) == IST_IGNORE)
       continue;                 /* skip items to ignore */
-    s_set = node->cnts[ist->index];
+    s_set = _getcnt(node, ist->index, ist->cwd);
     if (s_set < ist->supp) {    /* if the set support is too low */
-      if (s_set & F_SKIP) _marksub(ist, node, ist->index, -1);
-      continue;                 /* mark subsets if necessary */
+      if ((s_set & F_CSKIP) && (COUNT(s_set) >= ist->supp))
+        _marksub(ist, node, ist->index, -1);
+      continue;                 /* mark subsets of reported groups */
     }                           /* and skip this item set */
+    /* (counters of non-candidates are marked with F_CSKIP, too, */
+    /* but their subsets must not be marked, see ist_addopt) */
     /* Note that this check automatically skips all item sets that */
-    /* are marked with the flag F_SKIP, because s_set is negative  */
+    /* are marked with the flag F_CSKIP, because s_set is negative */
     /* with this flag and thus necessarily smaller than ist->supp. */
     head = node->parent;        /* get subset support from parent */
     if (!head)                  /* if there is no parent (root node), */
       s_body = ist->tacnt;      /* get the total number of sets */
     else if (head->offset >= 0) /* if pure vectors are used */
-      s_body = head->cnts[ID(node) -head->offset];
+      s_body = _getcnt(head, ID(node) -head->offset, ist->cwd);
     else {                      /* if an identifier map is used */
-      map = head->cnts +(n = head->size);
-      s_body = head->cnts[_bsearch(map, n, ID(node))];
+      map = MAP(head, ist->cwd); n = head->size;
+      s_body = _getcnt(head, _search(head, map, n, ID(node)), ist->cwd);
     }                           /* find index and get the support */
     s_body = COUNT(s_body);     /* get the support of body and head */
-    s_head = COUNT(ist->lvls[0]->cnts[item]);
+    s_head = COUNT(_getcnt(ist->lvls[0], item, ist->cwd));
     v = _evalfns[ist->arem](s_set, s_body, s_head, ist->tacnt);
+    plen = 1;                   /* initialize the path */
+    path = ist->buf +ist->vsz;  /* (store first item, which also */
+    *--path = item;             /* works with an identifier map) */
     item = ID(node);            /* note the next head item */
-    plen = 1;                   /* and initialize the path */
-    path = ist->buf +ist->vsz;  /* (store first item) */
-    *--path = ist->index +node->offset;
     while (head) {              /* traverse the path up to root */
-      s_body  = COUNT(_getsupp(head, path, plen));
+      s_body  = COUNT(_getsupp(head, path, plen, ist->cwd));
       *--path = item; plen++;   /* store the previous head item */
       item    = ID(head);       /* in the path (extend path) */
-      s_head  = COUNT(ist->lvls[0]->cnts[item]);
+      s_head  = COUNT(_getcnt(ist->lvls[0], item, ist->cwd));
       t = _evalfns[ist->arem](s_set, s_body, s_head, ist->tacnt);
       if (t < v) v = t;         /* compute the add. evaluation */
       head = head->parent;      /* and go to the parent node */
@@ -1355,7 +2837,7 @@ int ist_group (ISTREE *ist, int *group, int *supp, double *aval)
   /* --- build hyperedge --- */
   i = ist->size -1;             /* store the first item */
   if (node->offset >= 0) group[i] = ist->index +node->offset;
-  else                   group[i] = node->cnts[node->size +ist->index];
+  else                   group[i] = MAP(node, ist->cwd)[ist->index];
   while (node->parent) {        /* while not at the root node */
     group[--i] = ID(node);      /* add item to the hyperedge */
     node = node->parent;        /* and go to the parent node */
@@ -1366,7 +2848,7 @@ int ist_group (ISTREE *ist, int *group, int *supp, double *aval)
 /*--------------------------------------------------------------------*/
 #ifndef NDEBUG
 
-static void _showtree (ISNODE *node, int level)
+static void _showtree (ISNODE *node, int level, int w)
 {                               /* --- show subtree */
   int    i, k;                  /* loop variables, buffer */
   int    *map, n;               /* identifier map and its size */
@@ -1378,10 +2860,10 @@ static void _showtree (ISNODE *node, int level)
   if      (c <= 0)              /* if there are no children, */
     vec = NULL;                 /* clear the child vector variable */
   else if (node->offset >= 0)   /* if a pure vector is used */
-    vec = (ISNODE**)(node->cnts +node->size);
+    vec = node->chvec;
   else {                        /* if an identifier map is used */
-    map = node->cnts +(n = node->size);
-    vec = (ISNODE**)(map +n);   /* get id. map and child vector */
+    map = MAP(node, w); n = node->size;
+    vec = node->chvec;          /* get the child vector */
     if (c < n)                  /* if a secondary id. map exists, */
       map = (int*)(vec +(n = c));      /* get this identifier map */
   }                             /* get child access variables */
@@ -1389,13 +2871,13 @@ static void _showtree (ISNODE *node, int level)
     for (k = level; --k >= 0; ) /* indent and print */
       printf("   ");            /* item identifier and counter */
     if (node->offset >= 0) k = node->offset +i;
-    else                   k = node->cnts[node->size +i];
-    printf("%d: %d\n", k, COUNT(node->cnts[i]));
+    else                   k = MAP(node, w)[i];
+    printf("%d: " SUPP_FMT "\n", k, COUNT(_getcnt(node, i, w)));
     if (!vec) continue;         /* check whether there are children */
     if (node->offset >= 0) k -= ID(vec[0]);
     else                   k = _bsearch(map, n, k);
     if ((k >= 0) && (k < c) && vec[k])
-      _showtree(vec[k], level +1);
+      _showtree(vec[k], level +1, w);
   }                             /* show subtree recursively */
 }  /* _showtree() */
 
@@ -1404,8 +2886,9 @@ static void _showtree (ISNODE *node, int level)
 void ist_show (ISTREE *ist)
 {                               /* --- show an item set tree */
   assert(ist);                  /* check the function argument */
-  _showtree(ist->lvls[0], 0);   /* show nodes recursively */
-  printf("total: %d\n", ist->tacnt);
-}  /* ist_show() */             /* print number of transactions */
+  _showtree(ist->lvls[0], 0, ist->cwd);
+  printf("total: " SUPP_FMT "\n", ist->tacnt);
+}  /* ist_show() */             /* show the nodes recursively and */
+                                /* print number of transactions */
 
 #endif
@@ -33,10 +33,32 @@
             2003.08.11 item set filtering generalized (ist_filter)
             2004.05.09 parameter 'aval' added to function ist_set
             2008.03.24 creation based on ITEMSET structure
+            2026.10.19 ISNODE.sofs and ISTREE.thcnt added (threads),
+                       function ist_counts added
+            2026.10.19 negative thread number for atomic counting
+            2026.10.19 ISNODE.chvec and ISTREE.arns added (arenas)
+            2026.10.19 ISTREE.cwd added (counter width)
+            2026.10.19 support values changed to type SUPP
+            2026.10.19 ISTREE.htree added (hash tree counting)
+            2026.10.19 ISTREE.ucnt and function ist_addopt added
+            2026.10.19 ISTREE.thcnt also used for candidate generation
+            2026.10.19 ISTREE.tri and ISTREE.tofs added (pair counting),
+                       ist_filter and ist_init return an error code
+            2026.10.19 function ist_pairs added
+            2026.10.19 ISTREE.tcnt and function ist_recode added
+            2026.10.19 function ist_fill added (external supports)
+            2026.10.19 function ist_setsupp added (rising support)
+            2026.10.19 ISTREE.tids and function ist_tidcnt added
+            2026.10.19 search mode IST_CARS added (class assoc. rules)
+            2026.10.19 IST_CONTR, ISTREE.grps, and ist_cset added
+            2026.10.19 ISNODE.sofs changed to size_t (alignment)
+            2026.10.19 search modes IST_CNT32 and IST_CNT64 added
+            2026.10.19 macro ist_getsupp added
 ----------------------------------------------------------------------*/
 #ifndef __ISTREE__
 #define __ISTREE__
 #include "tract.h"
+#include "hshtree.h"
 
 /*----------------------------------------------------------------------
   Preprocessor Definitions
@@ -59,6 +81,17 @@
 
 /* --- search mode flags --- */
 #define IST_MEMOPT  4           /* optimize memory usage */
+#define IST_HASH    8           /* count with a hash tree */
+#define IST_PAIRS   16          /* count pairs in a triangular array */
+#define IST_TIDS    32          /* count with candidate id. lists */
+#define IST_CARS    64          /* class association rules only */
+                                /* (head only items are the classes, */
+                                /* all other items are body only) */
+#define IST_CONTR   128         /* contrast sets of two groups */
+                                /* (with IST_CARS: the two classes */
+                                /* are group labels) */
+#define IST_CNT32   256         /* use at least 32 bit counters */
+#define IST_CNT64   512         /* use 64 bit counters */
 
 /* --- item set filter modes --- */
 #define IST_CLEAR   0           /* clear markers */
@@ -71,22 +104,33 @@
 typedef struct _isnode {        /* --- item set node --- */
   struct _isnode *parent;       /* parent node */
   struct _isnode *succ;         /* successor node on same level */
+  struct _isnode **chvec;       /* child node vector */
   int            id;            /* identifier used in parent node */
   int            chcnt;         /* number of child nodes */
   int            size;          /* size   of counter vector */
   int            offset;        /* offset of counter vector */
+  size_t         sofs;          /* offset of counters in shadows */
   int            cnts[1];       /* counter vector */
 } ISNODE;                       /* (item set node) */
+/* Four pointer sized and four int fields keep the counter vector     */
+/* aligned to 8 bytes (64 bit counters and their atomic increments)   */
+/* on 32 as well as on 64 bit systems, whether ARCH64 is set or not. */
 
 typedef struct {                /* --- item set tree --- */
   ITEMSET *set;                 /* underlying item set */
   int     mode;                 /* search mode (e.g. support def.) */
-  int     tacnt;                /* number of transactions */
+  SUPP    tacnt;                /* number of transactions */
+  int     cwd;                  /* counter width (2, 4, or 8 bytes) */
+  int     thcnt;                /* number of threads for counting */
+                                /* and candidate generation */
+                                /* (< 0: only shared counters) */
   int     vsz;                  /* size of level vector */
   int     height;               /* tree height (number of levels) */
+  int     ucnt;                 /* number of uncounted levels */
   ISNODE  **lvls;               /* first node of each level */
-  int     rule;                 /* minimal support of an assoc. rule */
-  int     supp;                 /* minimal support of an item set */
+  void    **arns;               /* memory arena of each level */
+  SUPP    rule;                 /* minimal support of an assoc. rule */
+  SUPP    supp;                 /* minimal support of an item set */
   double  conf;                 /* minimal confidence of a rule */
   int     arem;                 /* additional rule evaluation measure */
   double  minval;               /* minimal evaluation measure value */
@@ -101,6 +145,12 @@ typedef struct {                /* --- item set tree --- */
   int     plen;                 /* current path length */
   int     hdonly;               /* head only item in current set */
   int     *map;                 /* to create identifier maps */
+  HTREE   *htree;               /* hash tree for counting (IST_HASH) */
+  void    *tri;                 /* triangular array of pair counters */
+  size_t  *tofs;                /* row offsets in triangular array */
+  int     tcnt;                 /* number of items in tri. array */
+  void    *tids;                /* candidate ids. of the transactions */
+  int     grps[2];              /* group labels (contrast sets) */
 #ifdef BENCH                    /* if benchmark version */
   int     sccnt;                /* number of support counters */
   int     scnec;                /* number of necessary supp. counters */
@@ -110,39 +160,53 @@ typedef struct {                /* --- item set tree --- */
 #endif
 } ISTREE;                       /* (item set tree) */
 
+typedef SUPP ISSUPPFN (const int *set, int cnt, void *data);
+/* function to get the support of an item set (items ascending) */
+
 /*----------------------------------------------------------------------
   Functions
 ----------------------------------------------------------------------*/
 extern ISTREE* ist_create  (ITEMSET *set, int mode,
-                            int supp, double conf);
+                            SUPP supp, double conf);
 extern void    ist_delete  (ISTREE *ist);
 extern int     ist_itemcnt (ISTREE *ist);
 
 extern void    ist_count   (ISTREE *ist, int *set, int cnt);
 extern void    ist_countx  (ISTREE *ist, TATREE *tat);
-extern int     ist_settac  (ISTREE *ist, int cnt);
-extern int     ist_gettac  (ISTREE *ist);
+extern void    ist_counts  (ISTREE *ist, TASET  *taset);
+extern int     ist_tidcnt  (ISTREE *ist, TASET  *taset);
+extern void    ist_setthr  (ISTREE *ist, int cnt);
+extern SUPP    ist_settac  (ISTREE *ist, SUPP cnt);
+extern SUPP    ist_gettac  (ISTREE *ist);
 extern int     ist_check   (ISTREE *ist, char *marks);
+extern void    ist_setsupp (ISTREE *ist, SUPP supp);
 extern int     ist_addlvl  (ISTREE *ist);
+extern int     ist_addopt  (ISTREE *ist);
+extern int     ist_pairs   (ISTREE *ist);
+extern int     ist_recode  (ISTREE *ist, char *marks, int *map);
+extern void    ist_fill    (ISTREE *ist, ISSUPPFN *getsupp,
+                            void *data);
 extern int     ist_height  (ISTREE *ist);
 
 extern void    ist_up      (ISTREE *ist, int root);
 extern int     ist_down    (ISTREE *ist, int item);
 extern int     ist_next    (ISTREE *ist, int item);
-extern void    ist_setcnt  (ISTREE *ist, int item, int cnt);
-extern int     ist_getcnt  (ISTREE *ist, int item);
-extern int     ist_getcntx (ISTREE *ist, int *set, int cnt);
+extern void    ist_setcnt  (ISTREE *ist, int item, SUPP cnt);
+extern SUPP    ist_getcnt  (ISTREE *ist, int item);
+extern SUPP    ist_getcntx (ISTREE *ist, int *set, int cnt);
 
-extern void    ist_filter  (ISTREE *ist, int mode);
-extern void    ist_init    (ISTREE *ist, int minlen,
+extern int     ist_filter  (ISTREE *ist, int mode);
+extern int     ist_init    (ISTREE *ist, int minlen,
                             int arem, double minval);
-extern int     ist_set     (ISTREE *ist, int *set,   int *supp,
+extern int     ist_set     (ISTREE *ist, int *set,   SUPP *supp,
+                            double *aval);
+extern int     ist_cset    (ISTREE *ist, int *set,   SUPP *supp,
                             double *aval);
-extern int     ist_rule    (ISTREE *ist, int *rule,  int *supp,
+extern int     ist_rule    (ISTREE *ist, int *rule,  SUPP *supp,
                             double *conf, double *lift, double *aval);
-extern int     ist_hedge   (ISTREE *ist, int *hedge, int *supp,
+extern int     ist_hedge   (ISTREE *ist, int *hedge, SUPP *supp,
                             double *conf, double *aval);
-extern int     ist_group   (ISTREE *ist, int *asmb,  int *supp,
+extern int     ist_group   (ISTREE *ist, int *asmb,  SUPP *supp,
                             double *aval);
 
 #ifndef NDEBUG
@@ -155,6 +219,8 @@ extern void    ist_show    (ISTREE *ist);
 #define ist_itemcnt(t)     ((t)->levels[0]->size)
 #define ist_settac(t,n)    ((t)->tacnt = (n))
 #define ist_gettac(t)      ((t)->tacnt)
+#define ist_getsupp(t)     ((t)->supp)
+#define ist_setthr(t,n)    ((t)->thcnt = ((n) != 0) ? (n) : 1)
 #define ist_height(t)      ((t)->height)
 
 #endif
@@ -0,0 +1,244 @@
+/*----------------------------------------------------------------------
+  File    : lcm.c
+  Contents: LCM algorithm for finding closed item sets
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 item appearances respected (head only items)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <assert.h>
+#include "lcm.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  The LCM algorithm (Uno et al. 2004) enumerates the closed item sets
+directly, without generating the (possibly exponentially many) other
+frequent item sets. A closed item set Q is extended by an item e that
+is not in Q and that follows the core item of Q (the item with which
+Q was generated) and the closure of Q u {e} (the intersection of all
+transactions that contain Q u {e}) is computed. The result is kept
+only if the closure does not contain any new item that precedes e
+(prefix preserving closure extension). With this test every closed
+item set is generated exactly once (from a unique parent), so that no
+repository of already found sets is needed and the search runs in time
+that depends only on the number of closed item sets.
+  The closure and the supports of all extensions are obtained in one
+pass over the transactions that contain the current set (occurrence
+deliver): the items of these transactions are counted and the items
+that occur in all of them form the closure. The identifiers of these
+transactions are then delivered to the frequent extensions, which
+yields the transaction lists with which the search proceeds.
+  Items to ignore are removed and, as in the item set tree, a set may
+contain at most one head only item. Closedness is decided in this
+restricted search space: a set without a head only item is closed only
+if no head only item occurs in all of its transactions (and then none
+of its extensions is closed either, so the search is pruned), and the
+sets with a head only item are found by a search for each such item,
+in which only the transactions containing it are considered and the
+other head only items are not part of any closure or extension.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- an extension of a closed set --- */
+  int     item;                 /* extension item (frequency rank) */
+  int     cnt;                  /* number of transaction identifiers */
+  int     *tids;                /* identifiers of the transactions */
+} LCMEXT;                       /* (extension of a closed set) */
+
+typedef struct {                /* --- LCM search data --- */
+  SUPP    supp;                 /* minimal support of an item set */
+  int     min, max;             /* minimal and maximal set size */
+  ISREPFN *report;              /* item set report function */
+  void    *data;                /* data for the report function */
+  int     *codes;               /* map from ranks to item codes */
+  int     *set;                 /* current item set (as ranks) */
+  int     *out;                 /* buffer for reported item sets */
+  int     **tras;               /* transactions (ranks, -1 terminated) */
+  int     *cnts;                /* occurrence counters of the items */
+  int     *used;                /* items with nonzero counters */
+  int     *map;                 /* map from ranks to extensions */
+  char    *marks;               /* flags for items in the current set */
+  char    *hdonly;              /* flags for head only items (ranks) */
+  int     head;                 /* whether set has a head only item */
+} LCM;                          /* (LCM search data) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int _report (LCM *lcm, int cnt, SUPP supp)
+{                               /* --- report an item set */
+  int i;                        /* loop variable */
+
+  assert(lcm && (cnt > 0));     /* check the function arguments */
+  for (i = cnt; --i >= 0; )     /* map the ranks to item codes */
+    lcm->out[i] = lcm->codes[lcm->set[i]];
+  ta_sort(lcm->out, cnt);       /* sort the items of the set */
+  return lcm->report(lcm->out, cnt, supp, lcm->data);
+}  /* _report() */
+
+/*--------------------------------------------------------------------*/
+
+static int _closed (LCM *lcm, const int *tids, int n, int item, int len)
+{                               /* --- recursive part of LCM */
+  int    i, k, c, m, e, r;      /* loop variables, buffers */
+  int    *t, *p;                /* to traverse the items/identifiers */
+  int    *cnts = lcm->cnts;     /* occurrence counters of the items */
+  int    *map  = lcm->map;      /* map from ranks to extensions */
+  size_t total;                 /* total size of the extension lists */
+  LCMEXT *exts, *x;             /* extensions of the closed set */
+
+  assert(lcm && tids && (n > 0));   /* check the function arguments */
+  for (c = 0, k = n; --k >= 0; )    /* count the items in the */
+    for (t = lcm->tras[tids[k]]; *t >= 0; t++)  /* transactions */
+      if (cnts[*t]++ <= 0) lcm->used[c++] = *t;
+  for (r = 0, m = len, i = 0; i < c; i++) {
+    k = lcm->used[i];           /* traverse the counted items */
+    if ((cnts[k] < n) || lcm->marks[k])
+      continue;                 /* skip items not in the closure */
+    if (lcm->hdonly[k]) {       /* if a head only item is in it, */
+      if (lcm->head) continue;  /* skip it for a set with one, */
+      r = -1; break;            /* otherwise neither the set nor any */
+    }                           /* extension is closed, so abort */
+    if (k < item) { r = -1; break; }   /* check whether the */
+    lcm->set[m++] = k;          /* closure extension is prefix */
+  }                             /* preserving (no new smaller item) */
+  if ((r < 0) || (m > lcm->max)) {
+    for (i = 0; i < c; i++) cnts[lcm->used[i]] = 0;
+    return 0;                   /* if the extension is not prefix */
+  }                             /* preserving, abort the search */
+  for (i = len; i < m; i++)     /* mark the items of the closed set */
+    lcm->marks[lcm->set[i]] = 1;
+  if ((m >= lcm->min) && (m > 0)/* if the set is large enough, */
+  &&  (_report(lcm, m, (SUPP)n) < 0)) /* report the closed set */
+    r = -1;
+  e = 0; total = 0;             /* init. the extension counters */
+  if ((r >= 0) && (m < lcm->max)) {
+    for (i = 0; i < c; i++) {   /* traverse the counted items */
+      k = lcm->used[i];         /* and count the frequent extensions */
+      if ((k > item) && !lcm->marks[k] && !lcm->hdonly[k]
+      &&  (cnts[k] >= lcm->supp)) {
+        e++; total += (size_t)cnts[k]; }
+    }                           /* (only items following the core */
+  }                             /* item and no head only items */
+                                /* can extend the set) */
+  exts = NULL;                  /* create the extension lists */
+  if ((e > 0) && !(exts = (LCMEXT*)malloc(e *sizeof(LCMEXT)
+                                         +total *sizeof(int))))
+    r = -1;                     /* (identifiers follow the lists) */
+  p = (exts) ? (int*)(exts +e) : NULL;
+  for (x = exts, i = 0; i < c; i++) {
+    k = lcm->used[i];           /* traverse the counted items */
+    if (exts && (k > item) && !lcm->marks[k] && !lcm->hdonly[k]
+    &&  (cnts[k] >= lcm->supp)) {
+      map[k] = (int)(x -exts);  /* map the item to its extension */
+      x->item = k; x->cnt = 0;  /* and initialize the extension */
+      x->tids = p; p += cnts[k]; x++;
+    }                           /* (the counters give the sizes) */
+    cnts[k] = 0;                /* clear the occurrence counters */
+  }
+  if (exts) {                   /* if there are extensions */
+    for (k = 0; k < n; k++)     /* deliver the identifiers */
+      for (t = lcm->tras[tids[k]]; *t >= 0; t++)
+        if (map[*t] >= 0) {     /* traverse the transactions */
+          x = exts +map[*t];    /* and add their identifiers */
+          x->tids[x->cnt++] = tids[k];
+        }                       /* to the lists of the extensions */
+    for (i = 0; i < e; i++)     /* clear the extension map */
+      map[exts[i].item] = -1;
+    for (x = exts; (r >= 0) && (x < exts +e); x++)
+      r = _closed(lcm, x->tids, x->cnt, x->item, m);
+    free(exts);                 /* process the extensions recursively */
+  }                             /* and delete their lists */
+  for (i = len; i < m; i++)     /* unmark the items of the set */
+    lcm->marks[lcm->set[i]] = 0;
+  return r;                     /* return the error status */
+}  /* _closed() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int lcm_mine (TASET *taset, SUPP supp, int min, int max,
+              ISREPFN *report, void *data)
+{                               /* --- find closed item sets */
+  int     i, k, n, m;           /* loop variables, numbers of items */
+  int     *ranks, *p, *s;       /* item ranks, to traverse the items */
+  int     *tids, *htids;        /* identifiers of (all) transactions */
+  int     h, c;                 /* head only item, number of trans. */
+  SUPP    *frqs;                /* item frequencies */
+  ITEMSET *iset;                /* item set of the transactions */
+  LCM     lcm;                  /* search data */
+
+  assert(taset && report && (min > 0) && (max >= min));
+  iset = tas_itemset(taset);    /* get the item set and */
+  n    = is_cnt(iset);          /* the number of items */
+  if ((n <= 0) || (tas_cnt(taset) <= 0) || (tas_cnt(taset) < supp))
+    return 0;                   /* check for a possible result */
+  frqs = (SUPP*)calloc(n, sizeof(SUPP) +7*sizeof(int) +2*sizeof(char));
+  if (!frqs) return -1;         /* create the item vectors */
+  ranks      = (int*)(frqs +n); /* (frequencies, ranks, codes, */
+  lcm.codes  = ranks +n;        /* current item set, output buffer, */
+  lcm.set    = lcm.codes +n;    /* counters, used items, extension */
+  lcm.out    = lcm.set   +n;    /* map, item set markers, */
+  lcm.cnts   = lcm.out   +n;    /* head only flags) */
+  lcm.used   = lcm.cnts  +n;
+  lcm.map    = lcm.used  +n;
+  lcm.marks  = (char*)(lcm.map +n);
+  lcm.hdonly = lcm.marks +n;
+  for (i = tas_cnt(taset); --i >= 0; )
+    for (s = tas_tract(taset, i), k = tas_tsize(taset, i); --k >= 0; )
+      frqs[s[k]]++;             /* determine the item frequencies */
+  lcm.supp = (supp > 0) ? supp : 1;
+  for (m = i = 0; i < n; i++)   /* collect the frequent items */
+    if ((frqs[i] >= lcm.supp) && (is_getapp(iset, i) != APP_NONE))
+      lcm.codes[m++] = i;       /* (except items to ignore) */
+  for (i = 1; i < m; i++) {     /* sort the frequent items */
+    k = lcm.codes[i];           /* ascendingly w.r.t. frequency */
+    for (p = lcm.codes +i; (--p >= lcm.codes) && (frqs[*p] > frqs[k]); )
+      p[1] = *p;                /* (insertion sort keeps the order */
+    p[1] = k;                   /* of items with equal frequency) */
+  }
+  for (i = 0; i < n; i++) ranks[i] = lcm.map[i] = -1;
+  for (i = 0; i < m; i++) {     /* set the ranks and note */
+    ranks[lcm.codes[i]] = i;    /* which items are head only */
+    lcm.hdonly[i] = (char)(is_getapp(iset, lcm.codes[i]) == APP_HEAD);
+  }
+  lcm.tras = (int**)malloc(tas_cnt(taset) *sizeof(int*)
+                          +(tas_total(taset) +3*tas_cnt(taset))
+                          *sizeof(int));
+  if (!lcm.tras) { free(frqs); return -1; }
+  tids  = (int*)(lcm.tras +tas_cnt(taset));
+  htids = tids  +tas_cnt(taset);
+  p     = htids +tas_cnt(taset);/* create the transaction vectors */
+  for (i = 0; i < tas_cnt(taset); i++) {
+    s = tas_tract(taset, i);    /* traverse the transactions */
+    for (lcm.tras[i] = p, k = tas_tsize(taset, i); --k >= 0; )
+      if (ranks[s[k]] >= 0) *p++ = ranks[s[k]];
+    *p++ = -1; tids[i] = i;     /* replace the items by their ranks, */
+  }                             /* store a sentinel, note identifier */
+  lcm.min    = min;             /* note the search parameters */
+  lcm.max    = max;
+  lcm.report = report;
+  lcm.data   = data;
+  lcm.head   = 1;               /* find the closed item sets */
+  for (k = 0, h = 0; (k >= 0) && (h < m); h++) {
+    if (!lcm.hdonly[h]) continue;   /* with a head only item */
+    for (c = i = 0; i < tas_cnt(taset); i++)
+      for (p = lcm.tras[i]; *p >= 0; p++)
+        if (*p == h) { htids[c++] = i; break; }
+    lcm.set[0] = h; lcm.marks[h] = 1;  /* collect the transactions */
+    k = _closed(&lcm, htids, c, -1, 1);   /* containing the item */
+    lcm.marks[h] = 0;           /* and search them recursively */
+  }                             /* (the item is frequent) */
+  lcm.head = 0;                 /* find the closed item sets */
+  if (k >= 0)                   /* without a head only item */
+    k = _closed(&lcm, tids, tas_cnt(taset), -1, 0);
+  free(lcm.tras);               /* find closed item sets recursively */
+  free(frqs);                   /* and delete the transactions */
+  return k;                     /* and the item vectors */
+}  /* lcm_mine() */
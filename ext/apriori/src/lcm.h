@@ -0,0 +1,17 @@
+/*----------------------------------------------------------------------
+  File    : lcm.h
+  Contents: LCM algorithm for finding closed item sets
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __LCM__
+#define __LCM__
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int lcm_mine (TASET *taset, SUPP supp, int min, int max,
+                     ISREPFN *report, void *data);
+
+#endif
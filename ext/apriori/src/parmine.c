@@ -0,0 +1,383 @@
+/*----------------------------------------------------------------------
+  File    : parmine.c
+  Contents: parallel mining of projected transaction sets
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 item appearances respected (head only items)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#ifndef NOTHREADS
+#include <pthread.h>
+#endif
+#include "parmine.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  The search space is partitioned by the first item of the item sets,
+that is, by the item with the smallest code (which is the least
+frequent item if the items are coded ascendingly w.r.t. their
+frequency). The item sets that start with an item i are the set {i}
+and the sets {i} u S, where S is a frequent item set of the projection
+to i: the transactions that contain i, reduced to the items following
+i. The projections are independent of each other and are mined with
+a single-threaded function (e.g. eclat, FP-growth or apriori with an
+item set tree), so that they can be processed in parallel.
+  Each thread receives a range of projections (work packages), which
+it processes in ascending order, and steals the upper half of the
+open packages of another thread when its own range is exhausted. The
+item sets found in a projection are collected in a buffer, from which
+the calling thread reports them in the order of the projections, so
+that the output does not depend on the number of threads or on the
+scheduling of the threads.
+  Items to ignore get no projection and, as in the item set tree, a
+set may contain at most one head only item: the projection to a head
+only item does not contain any other head only items (the projections
+share the item set, so the mining function sees the appearances).
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE    256          /* block size for result vectors */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- projection data --- */
+  TASET    *taset;              /* transaction set to project */
+  SUPP     *frqs;               /* frequencies of the items */
+  size_t   *offs;               /* offsets of the item occurrences */
+  int      *occs;               /* occurrences (t.a. index, position) */
+  int      *items;              /* items to project to (ascending) */
+  int      cnt;                 /* number of items to project to */
+  SUPP     supp;                /* minimal support of an item set */
+  int      one;                 /* whether to report single items */
+  int      min, max;            /* size range of sets in projections */
+  PMMINEFN *mine;               /* function to mine a projection */
+} PMDATA;                       /* (projection data) */
+
+typedef struct {                /* --- prefix reporting data --- */
+  int      item;                /* item to add as a prefix */
+  int      *buf;                /* buffer for the extended sets */
+  ISREPFN  *report;             /* item set report function */
+  void     *data;               /* data for the report function */
+} PMPFX;                        /* (prefix reporting data) */
+
+#ifndef NOTHREADS
+typedef struct {                /* --- result of a projection --- */
+  int      *items;              /* sizes and items of found sets */
+  size_t   icnt, isz;           /* fill and size of item vector */
+  SUPP     *supps;              /* supports of the found sets */
+  size_t   scnt, ssz;           /* fill and size of support vector */
+  int      done;                /* whether the projection is mined */
+  int      err;                 /* error flag */
+} PMRES;                        /* (result of a projection) */
+
+typedef struct _pmthrd {        /* --- mining thread --- */
+  struct _parmine *pm;          /* shared parallel mining data */
+  int             id;           /* index of the thread */
+  pthread_t       tid;          /* thread identifier */
+  int             run;          /* whether the thread was started */
+  int             beg, end;     /* range of open projections */
+  pthread_mutex_t lock;         /* lock for the projection range */
+} PMTHREAD;                     /* (mining thread) */
+
+typedef struct _parmine {       /* --- parallel mining data --- */
+  PMDATA          *pd;          /* projection data */
+  PMRES           *res;         /* results of the projections */
+  int             thcnt;        /* number of threads */
+  PMTHREAD        *thds;        /* mining threads */
+  int             abort;        /* flag for aborting the search */
+  pthread_mutex_t lock;         /* lock and condition variable */
+  pthread_cond_t  cond;         /* for finished projections */
+} PARMINE;                      /* (parallel mining data) */
+#endif
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static TASET* _project (PMDATA *pd, int item)
+{                               /* --- project the transactions */
+  size_t  i;                    /* loop variable */
+  int     j, k, n;              /* loop variable, numbers of items */
+  int     *occ;                 /* occurrence of the item */
+  int     *s, *buf = NULL;      /* items after the item, buffer */
+  ITEMSET *iset;                /* item set of the transactions */
+  TASET   *proj;                /* projected transaction set */
+
+  assert(pd && (item >= 0));    /* check the function arguments */
+  iset = tas_itemset(pd->taset);
+  proj = tas_create(iset);      /* create a transaction set */
+  if (!proj) return NULL;       /* and for a head only item */
+  if ((is_getapp(iset, item) == APP_HEAD)    /* a buffer for the */
+  &&  !(buf = (int*)malloc((size_t)tas_max(pd->taset) *sizeof(int)))) {
+    tas_delete(proj, 0); return NULL; }   /* filtered items */
+  for (i = pd->offs[item]; i < pd->offs[item+1]; i++) {
+    occ = pd->occs +2*i;        /* traverse the occurrences */
+    s   = tas_tract(pd->taset, occ[0]) +occ[1]+1;
+    k   = tas_tsize(pd->taset, occ[0]) -occ[1] -1;
+    if (buf) {                  /* if the item is head only, */
+      for (n = j = 0; j < k; j++)   /* remove the other */
+        if (is_getapp(iset, s[j]) != APP_HEAD) buf[n++] = s[j];
+      s = buf; k = n;           /* head only items */
+    }                           /* (at most one per set) */
+    if ((k > 0)                 /* add the items after the item */
+    &&  (tas_add(proj, s, k) != 0)) {
+      free(buf); tas_delete(proj, 0); return NULL; }
+  }                             /* (empty transactions are skipped, */
+  free(buf);                    /* they cannot support a set {i} u S) */
+  return proj;                  /* return the projection */
+}  /* _project() */
+
+/*--------------------------------------------------------------------*/
+
+static int _prefix (const int *set, int cnt, SUPP supp, void *data)
+{                               /* --- report a set with its prefix */
+  PMPFX *pfx = (PMPFX*)data;    /* prefix reporting data */
+
+  pfx->buf[0] = pfx->item;      /* the projection item precedes */
+  memcpy(pfx->buf+1, set, (size_t)cnt *sizeof(int));
+  return pfx->report(pfx->buf, cnt+1, supp, pfx->data);
+}  /* _prefix() */              /* all items of the projection */
+
+/*--------------------------------------------------------------------*/
+
+static int _serial (PMDATA *pd, PMPFX *pfx)
+{                               /* --- mine projections serially */
+  int   k, r;                   /* loop variable, result */
+  TASET *proj;                  /* projected transaction set */
+
+  assert(pd && pfx);            /* check the function arguments */
+  for (k = 0; k < pd->cnt; k++) {
+    pfx->item = pd->items[k];   /* traverse the projection items */
+    if (pd->one                 /* report the single item set */
+    &&  (pfx->report(&pfx->item, 1, pd->frqs[pfx->item], pfx->data) < 0))
+      return -1;                /* (if single items are requested) */
+    if (pd->max < pd->min) continue;
+    proj = _project(pd, pfx->item);
+    if (!proj) return -1;       /* project the transactions */
+    r = pd->mine(proj, pd->supp, pd->min, pd->max, _prefix, pfx);
+    tas_delete(proj, 0);        /* mine the projection and */
+    if (r < 0) return -1;       /* delete it afterwards */
+  }
+  return 0;                     /* return 'ok' */
+}  /* _serial() */
+
+/*--------------------------------------------------------------------*/
+#ifndef NOTHREADS
+
+static int _collect (const int *set, int cnt, SUPP supp, void *data)
+{                               /* --- collect a found item set */
+  size_t k;                     /* new vector size */
+  void   *p;                    /* reallocated vector */
+  PMRES  *res = (PMRES*)data;   /* result of the projection */
+
+  if (res->scnt >= res->ssz) {  /* if the support vector is full */
+    k = res->ssz +((res->ssz > BLKSIZE) ? res->ssz >> 1 : BLKSIZE);
+    p = realloc(res->supps, k *sizeof(SUPP));
+    if (!p) return -1;          /* enlarge the support vector */
+    res->supps = (SUPP*)p; res->ssz = k;
+  }                             /* set the new vector and its size */
+  if (res->icnt +(size_t)cnt +1 > res->isz) {
+    k = res->isz +((res->isz > BLKSIZE) ? res->isz >> 1 : BLKSIZE);
+    if (k < res->icnt +(size_t)cnt +1) k = res->icnt +(size_t)cnt +1;
+    p = realloc(res->items, k *sizeof(int));
+    if (!p) return -1;          /* enlarge the item vector */
+    res->items = (int*)p; res->isz = k;
+  }                             /* set the new vector and its size */
+  res->supps[res->scnt++] = supp;
+  res->items[res->icnt++] = cnt;/* store the support, the size */
+  memcpy(res->items +res->icnt, set, (size_t)cnt *sizeof(int));
+  res->icnt += (size_t)cnt;     /* and the items of the set */
+  return 0;                     /* return 'ok' */
+}  /* _collect() */
+
+/*--------------------------------------------------------------------*/
+
+static int _getpkg (PARMINE *pm, PMTHREAD *thd)
+{                               /* --- get the next work package */
+  int      i, k, m;             /* loop variable, package indices */
+  PMTHREAD *vic;                /* thread to steal packages from */
+
+  pthread_mutex_lock(&thd->lock);
+  k = (thd->beg < thd->end) ? thd->beg++ : -1;
+  pthread_mutex_unlock(&thd->lock);
+  if (k >= 0) return k;         /* take a package of the own range */
+  for (i = 1; i < pm->thcnt; i++) {
+    vic = pm->thds +(thd->id +i) % pm->thcnt;
+    pthread_mutex_lock(&vic->lock);
+    k = vic->end;               /* traverse the other threads */
+    m = vic->end = k -((k -vic->beg +1) >> 1);
+    pthread_mutex_unlock(&vic->lock);
+    if (m >= k) continue;       /* steal the upper half of the open */
+    pthread_mutex_lock(&thd->lock);    /* packages of a thread */
+    thd->beg = m+1; thd->end = k;
+    pthread_mutex_unlock(&thd->lock);
+    return m;                   /* make the stolen packages the own */
+  }                             /* range and return the first one */
+  return -1;                    /* return 'no package left' */
+}  /* _getpkg() */
+
+/*--------------------------------------------------------------------*/
+
+static void* _minethrd (void *arg)
+{                               /* --- mining thread function */
+  int      k, stop;             /* work package, abort flag */
+  TASET    *proj;               /* projected transaction set */
+  PMRES    *res;                /* result of the projection */
+  PMTHREAD *thd = (PMTHREAD*)arg;  /* thread data and */
+  PARMINE  *pm  = thd->pm;      /* shared parallel mining data */
+  PMDATA   *pd  = pm->pd;       /* projection data */
+
+  while ((k = _getpkg(pm, thd)) >= 0) {
+    res = pm->res +k;           /* get the result of the projection */
+    if (pd->max >= pd->min) {   /* if sets are to be found */
+      proj = _project(pd, pd->items[k]);
+      if (!proj || (pd->mine(proj, pd->supp, pd->min, pd->max,
+                             _collect, res) < 0))
+        res->err = 1;           /* project the transactions */
+      if (proj) tas_delete(proj, 0);   /* and mine the projection */
+    }
+    pthread_mutex_lock(&pm->lock);
+    res->done = 1;              /* mark the projection as finished */
+    pthread_cond_broadcast(&pm->cond);
+    stop = pm->abort;           /* and notify the reporting thread */
+    pthread_mutex_unlock(&pm->lock);
+    if (stop) break;            /* if the search was aborted, */
+  }                             /* do not take further packages */
+  return NULL;                  /* return a dummy result */
+}  /* _minethrd() */
+
+/*--------------------------------------------------------------------*/
+
+static int _parallel (PMDATA *pd, PMPFX *pfx, int n)
+{                               /* --- mine projections in parallel */
+  int      k, c, r;             /* loop variables, result */
+  size_t   i;                   /* loop variable for found sets */
+  int      *s;                  /* to traverse the found sets */
+  PMRES    *res;                /* result of a projection */
+  PARMINE  pm;                  /* shared parallel mining data */
+  PMTHREAD *thds;               /* mining threads */
+
+  assert(pd && pfx && (n > 1)); /* check the function arguments */
+  thds   = (PMTHREAD*)malloc((size_t)n *sizeof(PMTHREAD));
+  pm.res = (PMRES*)   calloc((size_t)pd->cnt, sizeof(PMRES));
+  if (!thds || !pm.res) {       /* create the thread data */
+    free(pm.res); free(thds); return 1; }
+  pm.pd    = pd; pm.thcnt = n; pm.thds = thds; pm.abort = 0;
+  pthread_mutex_init(&pm.lock, NULL);
+  pthread_cond_init (&pm.cond, NULL);
+  for (k = 0; k < n; k++) {     /* initialize the thread data */
+    thds[k].pm  = &pm; thds[k].id = k; thds[k].run = 0;
+    thds[k].beg = (int)(((double)pd->cnt * k)    /n);
+    thds[k].end = (int)(((double)pd->cnt *(k+1)) /n);
+    pthread_mutex_init(&thds[k].lock, NULL);
+  }                             /* distribute the projections */
+  for (c = k = 0; k < n; k++)   /* start the mining threads */
+    c += thds[k].run = (pthread_create(&thds[k].tid, NULL,
+                                       _minethrd, thds+k) == 0);
+  r = (c > 0) ? 0 : 1;          /* (projections of threads that */
+                                /* failed are stolen by the others) */
+  /* --- report found item sets --- */
+  for (k = 0; (k < pd->cnt) && (r == 0); k++) {
+    res = pm.res +k;            /* traverse the projections in order */
+    pthread_mutex_lock(&pm.lock);
+    while (!res->done) pthread_cond_wait(&pm.cond, &pm.lock);
+    pthread_mutex_unlock(&pm.lock);
+    pfx->item = pd->items[k];   /* wait for the projection */
+    if (res->err) { r = -1; break; }
+    if (pd->one                 /* report the single item set */
+    &&  (pfx->report(&pfx->item, 1, pd->frqs[pfx->item], pfx->data) < 0))
+      r = -1;                   /* (if single items are requested) */
+    for (s = res->items, i = 0; (i < res->scnt) && (r == 0); i++) {
+      if (_prefix(s+1, *s, res->supps[i], pfx) < 0) r = -1;
+      s += *s +1;               /* report the found item sets */
+    }                           /* with the projection item */
+    free(res->items); res->items = NULL;
+    free(res->supps); res->supps = NULL;
+  }                             /* delete the reported sets */
+
+  /* --- clean up --- */
+  pthread_mutex_lock(&pm.lock);
+  pm.abort = 1;                 /* stop the threads (on an error) */
+  pthread_mutex_unlock(&pm.lock);
+  for (k = 0; k < n; k++)       /* wait for the mining threads */
+    if (thds[k].run) pthread_join(thds[k].tid, NULL);
+  for (k = 0; k < n; k++)       /* destroy the locks */
+    pthread_mutex_destroy(&thds[k].lock);
+  pthread_cond_destroy (&pm.cond);
+  pthread_mutex_destroy(&pm.lock);
+  for (k = 0; k < pd->cnt; k++) {
+    free(pm.res[k].items); free(pm.res[k].supps); }
+  free(pm.res); free(thds);     /* delete the unreported sets */
+  return r;                     /* and the thread data */
+}  /* _parallel() */
+
+#endif
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int pm_mine (TASET *taset, SUPP supp, int min, int max,
+             int thcnt, PMMINEFN *mine, ISREPFN *report, void *data)
+{                               /* --- mine projections in parallel */
+  int    i, k, n, m;            /* loop variables, numbers of items */
+  int    r = 1;                 /* result of the search */
+  int    *s;                    /* to traverse the transactions */
+  PMDATA pd;                    /* projection data */
+  PMPFX  pfx;                   /* prefix reporting data */
+
+  assert(taset && mine && report && (max >= min));
+  n = is_cnt(tas_itemset(taset));
+  if (n <= 0) return 0;         /* get the number of items */
+  pd.frqs  = (SUPP*)  calloc((size_t)n, sizeof(SUPP));
+  pd.offs  = (size_t*)malloc((size_t)(n+1) *sizeof(size_t));
+  pd.occs  = (int*)   malloc((2*(size_t)tas_total(taset)+1)
+                             *sizeof(int));
+  pd.items = (int*)   malloc((size_t)n *sizeof(int));
+  pfx.buf  = (int*)   malloc((size_t)(n+1) *sizeof(int));
+  if (!pd.frqs || !pd.offs || !pd.occs || !pd.items || !pfx.buf) {
+    free(pfx.buf); free(pd.items); free(pd.occs);
+    free(pd.offs); free(pd.frqs); return -1; }
+
+  /* --- build the occurrence lists --- */
+  for (i = tas_cnt(taset); --i >= 0; )
+    for (s = tas_tract(taset, i), k = tas_tsize(taset, i); --k >= 0; )
+      pd.frqs[s[k]]++;          /* determine the item frequencies */
+  for (pd.offs[0] = 0, i = 0; i < n; i++)
+    pd.offs[i+1] = pd.offs[i] +(size_t)pd.frqs[i];
+  for (i = 0; i < tas_cnt(taset); i++) {
+    for (s = tas_tract(taset, i), k = 0; k < tas_tsize(taset, i); k++){
+      pd.occs[2*pd.offs[s[k]]]   = i;  /* note the transaction */
+      pd.occs[2*pd.offs[s[k]]+1] = k;  /* and the position */
+      pd.offs[s[k]]++;          /* of each occurrence of an item */
+    }                           /* (the offsets are advanced and */
+  }                             /* thus point to the next list) */
+  for (i = n; i > 0; i--) pd.offs[i] = pd.offs[i-1];
+  pd.offs[0] = 0;               /* restore the list offsets */
+  for (m = i = 0; i < n; i++)   /* collect the frequent items */
+    if ((pd.frqs[i] >= supp)    /* (except items to ignore) */
+    &&  (is_getapp(tas_itemset(taset), i) != APP_NONE))
+      pd.items[m++] = i;
+
+  /* --- mine the projections --- */
+  pd.taset = taset; pd.cnt = m; /* store the search parameters */
+  pd.supp  = supp;  pd.mine = mine;
+  pd.one   = (min <= 1);        /* sets in a projection lack */
+  pd.min   = (min > 2) ? min-1 : 1;  /* the projection item */
+  pd.max   = max-1;
+  pfx.report = report; pfx.data = data;
+  #ifndef NOTHREADS             /* if to use multiple threads */
+  if ((thcnt > 1) && (m > 1))   /* mine the projections in parallel */
+    r = _parallel(&pd, &pfx, (thcnt < m) ? thcnt : m);
+  #endif                        /* (if threads can be started) */
+  if (r > 0) r = _serial(&pd, &pfx);
+  free(pfx.buf); free(pd.items); free(pd.occs);
+  free(pd.offs); free(pd.frqs); /* delete the work vectors */
+  return r;                     /* return the search result */
+}  /* pm_mine() */
@@ -0,0 +1,25 @@
+/*----------------------------------------------------------------------
+  File    : parmine.h
+  Contents: parallel mining of projected transaction sets
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#ifndef __PARMINE__
+#define __PARMINE__
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef int PMMINEFN (TASET *taset, SUPP supp, int min, int max,
+                      ISREPFN *report, void *data);
+/* function to find the frequent item sets of a transaction set */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int pm_mine (TASET *taset, SUPP supp, int min, int max,
+                    int thcnt, PMMINEFN *mine,
+                    ISREPFN *report, void *data);
+
+#endif
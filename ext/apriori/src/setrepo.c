@@ -0,0 +1,159 @@
+/*----------------------------------------------------------------------
+  File    : setrepo.c
+  Contents: item set repository (hash table of item sets)
+  Author  : agent
+  History : 2026.10.19 file created
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "setrepo.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE    1024         /* block size for the set vectors */
+#define SET(r,i)   ((r)->items +(r)->offs[i])   /* size and items */
+
+/*----------------------------------------------------------------------
+  The repository collects the item sets found by a search that works
+without an item set tree (e.g. FP-growth), so that their supports can
+be retrieved afterwards by the item set tree (see ist_fill). The sets
+are stored as their size followed by their items (in ascending order)
+in one item vector and are found with an open addressing hash table.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static unsigned _hash (const int *set, int cnt)
+{                               /* --- compute hash code of a set */
+  unsigned h = (unsigned)cnt;   /* hash code of the item set */
+
+  assert(set || (cnt <= 0));    /* check the function arguments */
+  while (--cnt >= 0)            /* combine the item identifiers */
+    h = (h ^ (unsigned)*set++) *16777619U;
+  return h ^ (h >> 15);         /* mix the high bits into the */
+}  /* _hash() */                /* low bits (table size is 2^k) */
+
+/*--------------------------------------------------------------------*/
+
+static int _find (SETREPO *rep, const int *set, int cnt)
+{                               /* --- find the bucket of a set */
+  unsigned i;                   /* bucket index */
+  int      *s;                  /* items of a stored set */
+
+  assert(rep && rep->htab);     /* check the function arguments */
+  i = _hash(set, cnt) & (unsigned)(rep->size-1);
+  while (rep->htab[i] > 0) {    /* traverse the occupied buckets */
+    s = SET(rep, rep->htab[i]-1);
+    if ((s[0] == cnt) && (memcmp(s+1, set, cnt *sizeof(int)) == 0))
+      break;                    /* if the set is found, abort */
+    i = (i+1) & (unsigned)(rep->size-1);
+  }                             /* otherwise try the next bucket */
+  return (int)i;                /* return the bucket index */
+}  /* _find() */
+
+/*--------------------------------------------------------------------*/
+
+static int _resize (SETREPO *rep)
+{                               /* --- enlarge the hash table */
+  int i, k, n;                  /* loop variable, bucket, new size */
+  int *s;                       /* items of a stored set */
+
+  assert(rep);                  /* check the function argument */
+  n = (rep->size > 0) ? rep->size +rep->size : 2*BLKSIZE;
+  free(rep->htab);              /* compute the new table size */
+  rep->htab = (int*)calloc(n, sizeof(int));
+  if (!rep->htab) { rep->size = 0; return -1; }
+  rep->size = n;                /* create a new hash table */
+  for (i = 0; i < rep->cnt; i++) {
+    s = SET(rep, i);            /* reinsert all stored sets */
+    k = _find(rep, s+1, s[0]);
+    rep->htab[k] = i+1;         /* (the sets are all different, */
+  }                             /* so a free bucket is found) */
+  return 0;                     /* return 'ok' */
+}  /* _resize() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+SETREPO* sr_create (void)
+{                               /* --- create an item set repository */
+  SETREPO *rep;                 /* created repository */
+
+  rep = (SETREPO*)calloc(1, sizeof(SETREPO));
+  if (!rep) return NULL;        /* allocate the repository body */
+  if (_resize(rep) != 0) { free(rep); return NULL; }
+  return rep;                   /* create an initial hash table */
+}  /* sr_create() */            /* and return the repository */
+
+/*--------------------------------------------------------------------*/
+
+void sr_delete (SETREPO *rep)
+{                               /* --- delete an item set repository */
+  assert(rep);                  /* check the function argument */
+  if (rep->items) free(rep->items);
+  if (rep->offs)  free(rep->offs);
+  if (rep->supps) free(rep->supps);
+  free(rep->htab);              /* delete the vectors */
+  free(rep);                    /* and the repository body */
+}  /* sr_delete() */
+
+/*--------------------------------------------------------------------*/
+
+int sr_add (SETREPO *rep, const int *set, int cnt, SUPP supp)
+{                               /* --- add an item set */
+  int    i, n;                  /* bucket index, new vector size */
+  size_t k;                     /* new item vector size */
+  void   *p;                    /* new vector */
+
+  assert(rep                    /* check the function arguments */
+     && (cnt >= 0) && (set || (cnt <= 0)));
+  if ((rep->cnt +1) *2 > rep->size) {
+    if (_resize(rep) != 0) return -1; }
+  i = _find(rep, set, cnt);     /* find the bucket of the set */
+  if (rep->htab[i] > 0) {       /* if the set is already stored, */
+    rep->supps[rep->htab[i]-1] = supp; return 0; }  /* update it */
+  if (rep->cnt >= rep->vsz) {   /* if the set vectors are full */
+    n = rep->vsz +((rep->vsz > BLKSIZE) ? rep->vsz >> 1 : BLKSIZE);
+    p = realloc(rep->supps, n *sizeof(SUPP));
+    if (!p) return -1;          /* enlarge the support vector */
+    rep->supps = (SUPP*)p;
+    p = realloc(rep->offs,  n *sizeof(size_t));
+    if (!p) return -1;          /* enlarge the offset vector */
+    rep->offs  = (size_t*)p;
+    rep->vsz   = n;             /* set the new vectors */
+  }                             /* and their size */
+  if (rep->icnt +(size_t)cnt +1 > rep->isz) {
+    k = rep->isz +((rep->isz > BLKSIZE) ? rep->isz >> 1 : BLKSIZE);
+    if (k < rep->icnt +(size_t)cnt +1) k = rep->icnt +(size_t)cnt +1;
+    p = realloc(rep->items, k *sizeof(int));
+    if (!p) return -1;          /* enlarge the item vector */
+    rep->items = (int*)p; rep->isz = k;
+  }                             /* set the new vector and its size */
+  rep->offs[rep->cnt]  = rep->icnt;
+  rep->supps[rep->cnt] = supp;  /* store the support and the items */
+  rep->items[rep->icnt++] = cnt;
+  memcpy(rep->items +rep->icnt, set, cnt *sizeof(int));
+  rep->icnt += (size_t)cnt;     /* store the size and the items */
+  rep->htab[i] = ++rep->cnt;    /* and insert the set into the table */
+  return 0;                     /* return 'ok' */
+}  /* sr_add() */
+
+/*--------------------------------------------------------------------*/
+
+SUPP sr_get (SETREPO *rep, const int *set, int cnt)
+{                               /* --- get the support of a set */
+  int i;                        /* bucket index */
+
+  assert(rep                    /* check the function arguments */
+     && (cnt >= 0) && (set || (cnt <= 0)));
+  i = _find(rep, set, cnt);     /* find the bucket of the set */
+  return (rep->htab[i] > 0) ? rep->supps[rep->htab[i]-1] : 0;
+}  /* sr_get() */               /* return the support of the set */
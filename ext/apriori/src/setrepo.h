@@ -0,0 +1,47 @@
+/*----------------------------------------------------------------------
+  File    : setrepo.h
+  Contents: item set repository (hash table of item sets)
+  Author  : agent
+  History : 2026.10.19 file created
+            2026.10.19 functions sr_size and sr_items added
+----------------------------------------------------------------------*/
+#ifndef __SETREPO__
+#define __SETREPO__
+#include <stddef.h>
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- item set repository --- */
+  int     cnt;                  /* number of item sets */
+  int     vsz;                  /* size of the set vectors */
+  int     size;                 /* size of the hash table */
+  int     *htab;                /* hash table (set indices +1) */
+  SUPP    *supps;               /* supports of the item sets */
+  size_t  *offs;                /* offsets of the sets in item vector */
+  int     *items;               /* item vector (size, items per set) */
+  size_t  isz;                  /* size of the item vector */
+  size_t  icnt;                 /* number of used vector elements */
+} SETREPO;                      /* (item set repository) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern SETREPO* sr_create (void);
+extern void     sr_delete (SETREPO *rep);
+extern int      sr_cnt    (SETREPO *rep);
+extern int      sr_add    (SETREPO *rep, const int *set, int cnt,
+                           SUPP supp);
+extern SUPP     sr_get    (SETREPO *rep, const int *set, int cnt);
+extern int      sr_size   (SETREPO *rep, int index);
+extern int*     sr_items  (SETREPO *rep, int index);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define sr_cnt(r)         ((r)->cnt)
+#define sr_size(r,i)      ((r)->items[(r)->offs[i]])
+#define sr_items(r,i)     ((r)->items +(r)->offs[i] +1)
+
+#endif
@@ -36,6 +36,12 @@
             2007.02.13 adapted to modified tabscan module
             2008.01.25 bug in function ise_eval fixed (prefix)
             2008.06.30 support argument to ise_eval changed to double
+            2026.10.19 path compression for transaction trees added
+            2026.10.19 item frequencies changed to type SUPP
+            2026.10.19 pair counting while reading added (is_pairs)
+            2026.10.19 hash filter for pairs added (is_dhp, DHP)
+            2026.10.19 function is_remap added (item permutation)
+            2026.10.19 function tas_ptsize added (prefix tree size)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -53,6 +59,9 @@
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 #define BLKSIZE  256            /* block size for enlarging vectors */
+#define PT_SIZE  1024           /* initial size of pair hash table */
+#define PHASH(a,b) (((unsigned)(a) *2654435761U) \
+                   ^((unsigned)(b) *2246822507U))  /* pair hash */
 
 #define LN_2     0.69314718055994530942   /* ln(2) */
 
@@ -125,20 +134,88 @@ static int _get_item (ITEMSET *iset, FILE *file)
 
 /*--------------------------------------------------------------------*/
 
+static ITEMPAIR* _pfind (ITEMPAIR *pairs, int size, int a, int b)
+{                               /* --- find a pair in a hash table */
+  unsigned h;                   /* hash value of the pair */
+
+  assert(pairs && (size > 0) && (a < b));
+  h = PHASH(a, b) & (unsigned)(size-1);
+  while ((pairs[h].a >= 0)      /* probe the table linearly */
+  &&    ((pairs[h].a != a) || (pairs[h].b != b)))
+    h = (h+1) & (unsigned)(size-1);
+  return pairs +h;              /* return the pair's entry */
+}  /* _pfind() */               /* or the empty entry to use */
+
+/*--------------------------------------------------------------------*/
+
+static int _prehash (ITEMSET *iset, int size, const int *map, int n)
+{                               /* --- rehash/recode the item pairs */
+  int      i, a, b;             /* loop variable, item identifiers */
+  ITEMPAIR *pairs, *p;          /* new hash table, to access entries */
+
+  assert(iset && iset->pairs && (size > 0));
+  pairs = (ITEMPAIR*)malloc((size_t)size *sizeof(ITEMPAIR));
+  if (!pairs) return -1;        /* create a new hash table */
+  for (i = size; --i >= 0; ) pairs[i].a = -1;
+  iset->pcnt = 0;               /* mark all entries as empty */
+  for (i = iset->psz; --i >= 0; ) {
+    if ((a = iset->pairs[i].a) < 0) continue;
+    b = iset->pairs[i].b;       /* traverse the old entries */
+    if (map) {                  /* if to recode the pairs */
+      a = map[a]; b = map[b];   /* get the new item codes */
+      if ((a >= n) || (b >= n)) continue;
+      if (a > b) { a = b; b = map[iset->pairs[i].a]; }
+    }                           /* skip pairs with removed items */
+    p = _pfind(pairs, size, a, b);
+    p->a = a; p->b = b;         /* store the pair in the new table */
+    p->frq = iset->pairs[i].frq;
+    iset->pcnt++;               /* count the stored pairs */
+  }
+  free(iset->pairs);            /* delete the old hash table */
+  iset->pairs = pairs;          /* and set the new one */
+  iset->psz   = size;
+  return 0;                     /* return 'ok' */
+}  /* _prehash() */
+
+/*--------------------------------------------------------------------*/
+
+static int _pcount (ITEMSET *iset, int a, int b)
+{                               /* --- count an item pair */
+  ITEMPAIR *p;                  /* to access the pair's entry */
+
+  assert(iset && iset->pairs && (a < b));
+  if (iset->pcnt >= (iset->psz >> 1)) {
+    if ((iset->psz > (INT_MAX >> 1))
+    ||  (_prehash(iset, iset->psz << 1, NULL, 0) != 0))
+      return -1;                /* if the table is half full, */
+  }                             /* double its size */
+  p = _pfind(iset->pairs, iset->psz, a, b);
+  if (p->a < 0) {               /* if the pair is new, */
+    p->a = a; p->b = b;         /* store it in the table */
+    p->frq = 0; iset->pcnt++; }
+  p->frq += 1;                  /* count the item pair */
+  return 0;                     /* return 'ok' */
+}  /* _pcount() */
+
+/*--------------------------------------------------------------------*/
+
+static int _mapcmp (const void *p1, const void *p2, void *data)
+{                               /* --- compare new item codes */
+  int i1 = ((const int*)data)[((const ITEM*)p1)->id];
+  int i2 = ((const int*)data)[((const ITEM*)p2)->id];
+  return (i1 < i2) ? -1 : (i1 > i2) ? 1 : 0;
+}  /* _mapcmp() */
+
+/*--------------------------------------------------------------------*/
+
 static int _nocmp (const void *p1, const void *p2, void *data)
 {                               /* --- compare item frequencies */
   if (((const ITEM*)p1)->app == APP_NONE)
     return (((const ITEM*)p2)->app == APP_NONE) ? 0 : 1;
   if (((const ITEM*)p2)->app == APP_NONE) return -1;
-  #ifdef ARCH64
-  if (((const ITEM*)p1)->frq < (long)data)
-    return (((const ITEM*)p2)->frq < (long)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (long)data) return -1;
-  #else
-  if (((const ITEM*)p1)->frq < (int)data)
-    return (((const ITEM*)p2)->frq < (int)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (int)data) return -1;
-  #endif
+  if (((const ITEM*)p1)->frq < *(const SUPP*)data)
+    return (((const ITEM*)p2)->frq < *(const SUPP*)data) ? 0 : 1;
+  if (((const ITEM*)p2)->frq < *(const SUPP*)data) return -1;
   if (((const ITEM*)p1)->id  > ((const ITEM*)p2)->id) return  1;
   if (((const ITEM*)p1)->id  < ((const ITEM*)p2)->id) return -1;
   return 0;                     /* return sign of identifier diff. */
@@ -151,15 +228,9 @@ static int _asccmp (const void *p1, const void *p2, void *data)
   if (((const ITEM*)p1)->app == APP_NONE)
     return (((const ITEM*)p2)->app == APP_NONE) ? 0 : 1;
   if (((const ITEM*)p2)->app == APP_NONE) return -1;
-  #ifdef ARCH64
-  if (((const ITEM*)p1)->frq < (long)data)
-    return (((const ITEM*)p2)->frq < (long)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (long)data) return -1;
-  #else
-  if (((const ITEM*)p1)->frq < (int)data)
-    return (((const ITEM*)p2)->frq < (int)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (int)data) return -1;
-  #endif
+  if (((const ITEM*)p1)->frq < *(const SUPP*)data)
+    return (((const ITEM*)p2)->frq < *(const SUPP*)data) ? 0 : 1;
+  if (((const ITEM*)p2)->frq < *(const SUPP*)data) return -1;
   if (((const ITEM*)p1)->frq > ((const ITEM*)p2)->frq) return  1;
   if (((const ITEM*)p1)->frq < ((const ITEM*)p2)->frq) return -1;
   return 0;                     /* return sign of frequency diff. */
@@ -184,15 +255,9 @@ static int _asccmpx (const void *p1, const void *p2, void *data)
   if (((const ITEM*)p1)->app == APP_NONE)
     return (((const ITEM*)p2)->app == APP_NONE) ? 0 : 1;
   if (((const ITEM*)p2)->app == APP_NONE) return -1;
-  #ifdef ARCH64
-  if (((const ITEM*)p1)->frq < (long)data)
-    return (((const ITEM*)p2)->frq < (long)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (long)data) return -1;
-  #else
-  if (((const ITEM*)p1)->frq < (int)data)
-    return (((const ITEM*)p2)->frq < (int)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (int)data) return -1;
-  #endif
+  if (((const ITEM*)p1)->frq < *(const SUPP*)data)
+    return (((const ITEM*)p2)->frq < *(const SUPP*)data) ? 0 : 1;
+  if (((const ITEM*)p2)->frq < *(const SUPP*)data) return -1;
   if (((const ITEM*)p1)->xfq > ((const ITEM*)p2)->xfq) return  1;
   if (((const ITEM*)p1)->xfq < ((const ITEM*)p2)->xfq) return -1;
   return 0;                     /* return sign of frequency diff. */
@@ -205,15 +270,9 @@ static int _descmpx (const void *p1, const void *p2, void *data)
   if (((const ITEM*)p1)->app == APP_NONE)
     return (((const ITEM*)p2)->app == APP_NONE) ? 0 : 1;
   if (((const ITEM*)p2)->app == APP_NONE) return -1;
-  #ifdef ARCH64
-  if (((const ITEM*)p1)->frq < (long)data)
-    return (((const ITEM*)p2)->frq < (long)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (long)data) return -1;
-  #else
-  if (((const ITEM*)p1)->frq < (int)data)
-    return (((const ITEM*)p2)->frq < (int)data) ? 0 : 1;
-  if (((const ITEM*)p2)->frq < (int)data) return -1;
-  #endif
+  if (((const ITEM*)p1)->frq < *(const SUPP*)data)
+    return (((const ITEM*)p2)->frq < *(const SUPP*)data) ? 0 : 1;
+  if (((const ITEM*)p2)->frq < *(const SUPP*)data) return -1;
   if (((const ITEM*)p1)->xfq > ((const ITEM*)p2)->xfq) return -1;
   if (((const ITEM*)p1)->xfq < ((const ITEM*)p2)->xfq) return  1;
   return 0;                     /* return sign of frequency diff. */
@@ -238,6 +297,11 @@ ITEMSET* is_create (int cnt)
     is_delete(iset); return NULL; }
   iset->tac = iset->cnt = 0;    /* initialize the other fields */
   iset->app = APP_BOTH;
+  iset->psz = iset->pcnt = iset->pfix = 0;
+  iset->pairs = NULL;           /* pairs are not counted by default */
+  iset->bsz   = 0;              /* and not hashed to buckets */
+  iset->bkts  = NULL;
+  iset->raw   = NULL;
   iset->vsz = cnt;
   iset->chars[0] = ' ';  iset->chars[1] = ' ';
   iset->chars[2] = '\n'; iset->chars[3] = '\0';
@@ -250,6 +314,9 @@ void is_delete (ITEMSET *iset)
 {                               /* --- delete an item set */
   assert(iset);                 /* check the function argument */
   if (iset->items) free(iset->items);
+  if (iset->pairs) free(iset->pairs);
+  if (iset->bkts)  free(iset->bkts);
+  if (iset->raw)   free(iset->raw);
   if (iset->nimap) nim_delete(iset->nimap);
   if (iset->tscan) ts_delete(iset->tscan);
   free(iset);                   /* delete the components */
@@ -317,9 +384,63 @@ int is_readapp (ITEMSET *iset, FILE *file)
 
 /*--------------------------------------------------------------------*/
 
+int is_pairs (ITEMSET *iset)
+{                               /* --- count pairs while reading */
+  int i;                        /* loop variable */
+
+  assert(iset && !iset->pairs); /* check the function argument */
+  iset->pairs = (ITEMPAIR*)malloc(PT_SIZE *sizeof(ITEMPAIR));
+  if (!iset->pairs) return -1;  /* create a pair hash table */
+  for (i = PT_SIZE; --i >= 0; ) iset->pairs[i].a = -1;
+  iset->psz  = PT_SIZE;         /* mark all entries as empty */
+  iset->pcnt = iset->pfix = 0;  /* and initialize the counters */
+  return 0;                     /* return 'ok' */
+}  /* is_pairs() */
+
+/*--------------------------------------------------------------------*/
+
+SUPP is_getpfq (ITEMSET *iset, int a, int b)
+{                               /* --- get frequency of a pair */
+  int      t;                   /* exchange buffer */
+  ITEMPAIR *p;                  /* to access the pair's entry */
+
+  assert(iset && (a != b));     /* check the function arguments */
+  if (!iset->pairs) return 0;   /* check for pair counters */
+  if (a > b) { t = a; a = b; b = t; }
+  p = _pfind(iset->pairs, iset->psz, a, b);
+  return (p->a < 0) ? 0 : p->frq;
+}  /* is_getpfq() */            /* return the pair frequency */
+
+/*--------------------------------------------------------------------*/
+
+int is_dhp (ITEMSET *iset, int size)
+{                               /* --- hash pairs while reading */
+  assert(iset && !iset->bkts && (size > 0));
+  iset->bkts = (SUPP*)calloc((size_t)size, sizeof(SUPP));
+  if (!iset->bkts) return -1;   /* create the bucket counters */
+  iset->bsz  = size;            /* and note their number */
+  return 0;                     /* return 'ok' */
+}  /* is_dhp() */
+
+/*--------------------------------------------------------------------*/
+
+SUPP is_getbfq (ITEMSET *iset, int a, int b)
+{                               /* --- get bucket count of a pair */
+  int t;                        /* exchange buffer */
+
+  assert(iset && (a >= 0) && (b >= 0) && (a != b));
+  if (!iset->bkts || !iset->raw) /* if there are no buckets, */
+    return SUPP_MAX;            /* no pair can be excluded */
+  a = iset->raw[a]; b = iset->raw[b];
+  if (a > b) { t = a; a = b; b = t; }
+  return iset->bkts[PHASH(a, b) % (unsigned)iset->bsz];
+}  /* is_getbfq() */            /* return the count of the bucket */
+
+/*--------------------------------------------------------------------*/
+
 int is_read (ITEMSET *iset, FILE *file)
 {                               /* --- read a transaction */
-  int  i, d;                    /* loop variable, delimiter type */
+  int  i, k, d;                 /* loop variables, delimiter type */
   char *buf;                    /* read buffer */
   ITEM *item;                   /* pointer to item */
 
@@ -345,13 +466,25 @@ int is_read (ITEMSET *iset, FILE *file)
     item->frq += 1;             /* count the item and */
     item->xfq += iset->cnt;     /* sum the transaction sizes */
   }                             /* as an importance indicator */
+  if ((iset->pairs || iset->bkts) && !iset->pfix) {
+    for (i = 0; i < iset->cnt; i++) {   /* if to count item pairs, */
+      for (k = i+1; k < iset->cnt; k++) {   /* traverse all pairs */
+        if (iset->pairs         /* count the pair exactly */
+        && (_pcount(iset, iset->items[i], iset->items[k]) != 0))
+          return E_NOMEM;       /* and/or count its hash bucket */
+        if (iset->bkts)         /* (DHP hash filter) */
+          iset->bkts[PHASH(iset->items[i], iset->items[k])
+                     % (unsigned)iset->bsz] += 1;
+      }                         /* (the items are sorted, so that */
+    }                           /* the first item is always the */
+  }                             /* smaller identifier) */
   iset->tac += 1;               /* count the transaction */
   return 0;                     /* return 'ok' */
 }  /* is_read() */
 
 /*--------------------------------------------------------------------*/
 
-int is_recode (ITEMSET *iset, int minfrq, int dir, int *map)
+int is_recode (ITEMSET *iset, SUPP minfrq, int dir, int *map)
 {                               /* --- recode items w.r.t. frequency */
   int      i, k, n, t;          /* loop variables, buffer */
   ITEM     *item;               /* to traverse the items */
@@ -363,7 +496,7 @@ int is_recode (ITEMSET *iset, int minfrq, int dir, int *map)
   else if (dir >= 0) cmp = _nocmp;    /* (ascending/descending) */
   else if (dir > -2) cmp = _descmp;   /* and sort the items */
   else               cmp = _descmpx;  /* w.r.t. their frequency */
-  nim_sort(iset->nimap, cmp, (void*)minfrq, map, 1);
+  nim_sort(iset->nimap, cmp, &minfrq, map, 1);
   for (n = nim_cnt(iset->nimap); --n >= 0; ) {
     item = (ITEM*)nim_byid(iset->nimap, n);
     if (item->frq < minfrq)     /* determine frequent items and */
@@ -379,11 +512,59 @@ int is_recode (ITEMSET *iset, int minfrq, int dir, int *map)
     iset->cnt = k;              /* delete all items to ignore */
     ta_sort(iset->items, k);    /* resort the items */
   }
+  if (iset->pairs && !iset->pfix) {  /* if pairs have been counted */
+    for (k = 0, i = iset->psz; map && (--i >= 0); )
+      if ((iset->pairs[i].a >= 0)    /* count the pairs to keep */
+      &&  (map[iset->pairs[i].a] <= n) && (map[iset->pairs[i].b] <= n))
+        k++;                    /* (pairs of frequent items) */
+    for (i = PT_SIZE; (i >> 1) < k; i <<= 1);
+    if (!map || (_prehash(iset, i, map, n+1) != 0)) {
+      free(iset->pairs); iset->pairs = NULL;
+      iset->psz = iset->pcnt = 0;  /* recode the pair counters */
+    }                           /* (pairs with removed items are */
+    iset->pfix = 1;             /* dropped and, if there is no map */
+  }                             /* or memory, all counters are lost) */
+  if (iset->bkts && !iset->raw) {    /* if pairs have been hashed */
+    k = nim_cnt(iset->nimap);   /* get the number of items */
+    if (map) iset->raw = (int*)malloc(k *sizeof(int));
+    if (!iset->raw) {           /* create a map to the raw ids */
+      free(iset->bkts); iset->bkts = NULL; iset->bsz = 0; }
+    else {                      /* (the buckets are indexed with */
+      for (i = k; --i >= 0; )   /* the raw ids) */
+        iset->raw[map[i]] = i;  /* invert the identifier map */
+    }                           /* (including infrequent items) */
+    iset->pfix = 1;             /* (if the buckets are deleted, */
+  }                             /* no pair will be filtered) */
   return n+1;                   /* return number of frequent items */
 }  /* is_recode() */
 
 /*--------------------------------------------------------------------*/
 
+void is_remap (ITEMSET *iset, const int *map)
+{                               /* --- recode items with a map */
+  int i, n;                     /* loop variable, number of items */
+  int *raw;                     /* new map to raw identifiers */
+
+  assert(iset && map);          /* check the function arguments */
+  n = nim_cnt(iset->nimap);     /* get the number of items */
+  nim_sort(iset->nimap, _mapcmp, (void*)map, NULL, 0);
+  for (i = 0; i < iset->cnt; i++)  /* sort the items by their new */
+    iset->items[i] = map[iset->items[i]];  /* codes (permutation) */
+  ta_sort(iset->items, iset->cnt);  /* and recode the transaction */
+  if (iset->pairs && (_prehash(iset, iset->psz, map, n) != 0)) {
+    free(iset->pairs); iset->pairs = NULL;
+    iset->psz = iset->pcnt = 0; /* recode the pair counters */
+  }                             /* (or drop them on failure) */
+  if (iset->raw) {              /* if there is a raw id. map */
+    raw = (int*)malloc(n *sizeof(int));
+    if (raw) { for (i = n; --i >= 0; ) raw[map[i]] = iset->raw[i]; }
+    else     { free(iset->bkts); iset->bkts = NULL; iset->bsz = 0; }
+    free(iset->raw); iset->raw = raw;
+  }                             /* permute the raw identifiers */
+}  /* is_remap() */             /* (or drop the buckets on failure) */
+
+/*--------------------------------------------------------------------*/
+
 int is_filter (ITEMSET *iset, const char *marks)
 {                               /* --- filter items in transaction */
   return iset->cnt = ta_filter(iset->items, iset->cnt, marks);
@@ -393,7 +574,7 @@ int is_filter (ITEMSET *iset, const char *marks)
   Item Set Evaluation Functions
 ----------------------------------------------------------------------*/
 
-ISEVAL* ise_create (ITEMSET *iset, int tacnt)
+ISEVAL* ise_create (ITEMSET *iset, SUPP tacnt)
 {                               /* --- create an item set evaluation */
   int    i;                     /* loop variable */
   ISEVAL *eval;                 /* created item set evaluator */
@@ -402,9 +583,9 @@ ISEVAL* ise_create (ITEMSET *iset, int tacnt)
   eval = (ISEVAL*)malloc(sizeof(ISEVAL) +(i+i) *sizeof(double));
   if (!eval) return NULL;       /* create an evaluation object */
   eval->logfs = eval->lsums +i +1;  /* and organize the memory */
-  eval->logta = log(tacnt);     /* store log of number of trans. */
+  eval->logta = log((double)tacnt);     /* store log of number of trans. */
   while (--i >= 0)              /* compute logarithms of item freqs. */
-    eval->logfs[i] = log(is_getfrq(iset, i));
+    eval->logfs[i] = log((double)is_getfrq(iset, i));
   eval->lsums[0] = 0;           /* init. first sum of logarithms */
   return eval;                  /* return created item set evaluator */
 }  /* ise_create() */
@@ -692,6 +873,23 @@ int tas_occur (TASET *taset, const int *items, int n)
   return r -l;                  /* compute the number of occurrences */
 }  /* tas_occur() */
 
+/*--------------------------------------------------------------------*/
+
+int tas_ptsize (TASET *taset)
+{                               /* --- size of a prefix tree */
+  int   i, k, n;                /* loop variables, number of items */
+  TRACT *t, *p;                 /* to traverse the transactions */
+
+  assert(taset);                /* check the function argument */
+  for (p = NULL, n = i = 0; i < taset->cnt; p = t, i++) {
+    t = taset->tracts[i];       /* traverse the sorted transactions */
+    for (k = 0; p && (k < t->cnt) && (k < p->cnt); k++)
+      if (t->items[k] != p->items[k]) break;
+    n += t->cnt -k;             /* count the items that follow */
+  }                             /* the prefix shared with the */
+  return n;                     /* preceding transaction */
+}  /* tas_ptsize() */
+
 /*--------------------------------------------------------------------*/
 #ifndef NDEBUG
 
@@ -717,24 +915,74 @@ void tas_show (TASET *taset)
   Transaction Tree Functions
 ----------------------------------------------------------------------*/
 
+TATREE* _create (TRACT **tracts, int cnt, int index);
+
+/*--------------------------------------------------------------------*/
+
+static TATREE* _path (TRACT *t, int cnt, int index, int len,
+                      TATREE *tail)
+{                               /* --- create a path node */
+  int    i;                     /* padded number of items */
+  TATREE *tat;                  /* created transaction tree node */
+  int    *items;                /* items on the path */
+
+  assert(t && (cnt > 0) && (len > 0));
+  #ifdef ARCH64                 /* adapt to even item number */
+  i = (len & 1) ? len : (len+1);/* so that pointer addresses are */
+  #else                         /* multiples of 8 on 64 bit systems */
+  i = len;                      /* on 32 bit systems, however, */
+  #endif                        /* use the exact number of items */
+  tat = (TATREE*)malloc(sizeof(TATREE) +(i-1) *sizeof(int)
+                       + ((tail) ? sizeof(TATREE*) : 0));
+  if (!tat) { if (tail) tat_delete(tail); return NULL; }
+  tat->cnt  = cnt;              /* create a transaction tree node */
+  tat->size = -len;             /* and initialize its fields */
+  tat->max  =  len;
+  if (tail) {                   /* if there is a subtree, */
+    *(TATREE**)(tat->items +i) = tail;   /* store a pointer to it */
+    tat->max += tail->max;      /* and add its maximal size */
+  }                             /* (tat_tail() needs max > -size) */
+  items = t->items +index;      /* copy the common prefix */
+  while (--len >= 0) tat->items[len] = items[len];
+  return tat;                   /* return the created path node */
+}  /* _path() */
+
+/*--------------------------------------------------------------------*/
+
 TATREE* _create (TRACT **tracts, int cnt, int index)
 {                               /* --- recursive part of tat_create() */
   int    i, k, t;               /* loop variables, buffer */
   int    item, n;               /* item and item counter */
   TATREE *tat;                  /* created transaction tree */
   TATREE **vec;                 /* vector of child pointers */
+  TATREE *tail;                 /* subtree below a common prefix */
+  TRACT  *frst, *last;          /* first and last transaction */
 
   assert(tracts                 /* check the function arguments */
      && (cnt >= 0) && (index >= 0));
   if (cnt <= 1) {               /* if only one transaction left */
-    n   = (cnt > 0) ? (*tracts)->cnt -index : 0;
-    tat = (TATREE*)malloc(sizeof(TATREE) +(n-1) *sizeof(int));
+    n = (cnt > 0) ? (*tracts)->cnt -index : 0;
+    if (n > 0) return _path(*tracts, cnt, index, n, NULL);
+    tat = (TATREE*)malloc(sizeof(TATREE));
     if (!tat) return NULL;      /* create a transaction tree node */
-    tat->cnt  = cnt;            /* and initialize its fields */
-    tat->size = -n;
-    tat->max  =  n;
-    while (--n >= 0) tat->items[n] = (*tracts)->items[index +n];
-    return tat;
+    tat->cnt  = cnt;            /* for an empty (rest of a) trans. */
+    tat->size = tat->max = 0;   /* and initialize its fields */
+    return tat;                 /* return the created node */
+  }
+  frst = tracts[0];             /* get the first and last transaction */
+  last = tracts[cnt-1];         /* (all t.a. lie between them) */
+  if (frst->cnt > index) {      /* if no transaction ends here, */
+    n = frst->cnt;              /* find the common prefix of all t.a. */
+    for (k = index; (k < n) && (frst->items[k] == last->items[k]); )
+      k++;                      /* (sorted, so first and last suffice) */
+    if (k > index) {            /* if there is a common prefix, */
+      tail = NULL;              /* compress it into a path node */
+      if (last->cnt > k) {      /* if some t.a. are longer than it, */
+        tail = _create(tracts, cnt, k);  /* create the subtree */
+        if (!tail) return NULL; /* below the common prefix */
+      }                         /* (at least two t.a. differ there) */
+      return _path(frst, cnt, index, k -index, tail);
+    }                           /* create a path node */
   }
   for (k = cnt; (--k >= 0) && ((*tracts)->cnt <= index); )
     tracts++;                   /* skip t.a. that are too short */
@@ -797,6 +1045,11 @@ void tat_delete (TATREE *tat)
   TATREE **vec;                 /* vector of child nodes */
 
   assert(tat);                  /* check the function argument */
+  if (tat->size < 0) {          /* if this is a path node */
+    if (tat->max > -tat->size)  /* if there is a subtree, */
+      tat_delete(tat_tail(tat));/* delete it recursively */
+    free(tat); return;          /* delete the path node */
+  }                             /* and abort the function */
   #ifdef ARCH64                 /* if 64 bit architecture */
   i = (tat->size & 1) ? tat->size : (tat->size+1);
   #else                         /* address must be a multiple of 8 */
@@ -821,6 +1074,19 @@ TATREE* tat_child (TATREE *tat, int index)
   return ((TATREE**)(tat->items +s))[index];
 }  /* tat_child */              /* return the child node/subtree */
 
+/*--------------------------------------------------------------------*/
+
+TATREE* tat_tail (TATREE *tat)
+{                               /* --- get the subtree below a path */
+  int s;                        /* padded size of the node */
+
+  assert(tat && (tat->size < 0));  /* check the function argument */
+  if (tat->max <= -tat->size)   /* if all transactions end */
+    return NULL;                /* with the path, there is no subtree */
+  s = (tat->size & 1) ? -tat->size : (1 -tat->size);
+  return *(TATREE**)(tat->items +s);
+}  /* tat_tail */               /* return the subtree */
+
 #endif
 /*--------------------------------------------------------------------*/
 
@@ -829,12 +1095,15 @@ void tat_mark (TATREE *tat)
   int i;                        /* loop variable */
 
   assert(tat);                  /* check the function argument */
-  if      (tat->size < 0)       /* if there is a transaction, */
+  if      (tat->max > -tat->size) {
+    if (tat->size < 0)          /* if there is a subtree below a path, */
+      tat_mark(tat_tail(tat));  /* mark the subtree recursively */
+    else {                      /* if there are subtrees */
+      for (i = tat->size; --i >= 0; )
+        tat_mark(tat_child(tat, i));
+    } }                         /* recursively mark the subtrees */
+  else if (tat->size < 0)       /* if there is a transaction, */
     tat->items[tat->max-1] |= INT_MIN;  /* mark end of trans. */
-  else {                        /* if there are subtrees */
-    for (i = tat->size; --i >= 0; )
-      tat_mark(tat_child(tat, i));
-  }                             /* recursively mark the subtrees */
 }  /* tat_mark() */
 
 /*--------------------------------------------------------------------*/
@@ -846,11 +1115,14 @@ void _show (TATREE *tat, int ind)
   TATREE **vec;                 /* vector of child nodes */
 
   assert(tat && (ind >= 0));    /* check the function arguments */
-  if (tat->size <= 0) {         /* if this is a leaf node */
-    for (i = 0; i < tat->max; i++)
+  if (tat->size <= 0) {         /* if this is a path node */
+    for (i = 0; i < -tat->size; i++)
       printf("%d ", tat->items[i] & ~INT_MIN);
-    printf("\n"); return;       /* print the items in the */
-  }                             /* (rest of) the transaction */
+    if (tat->max > -tat->size)  /* print the items on the path */
+      _show(tat_tail(tat), ind -tat->size);
+    else printf("\n");          /* show a subtree recursively */
+    return;                     /* or terminate the transaction */
+  }
   vec = (TATREE**)(tat->items +tat->size);
   for (i = 0; i < tat->size; i++) {
     if (i > 0) for (k = ind; --k >= 0; ) printf("  ");
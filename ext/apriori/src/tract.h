@@ -16,9 +16,17 @@
             2006.11.26 structures ISFMTR and ISEVAL added
             2007.02.13 adapted to modified tabscan module
             2008.06.30 support argument to ise_eval changed to double
+            2026.10.19 path nodes and function tat_tail added
+            2026.10.19 type SUPP added (64 bit support values)
+            2026.10.19 pair counting while reading added (is_pairs)
+            2026.10.19 hash filter for pairs added (is_dhp, DHP)
+            2026.10.19 function is_remap added (item permutation)
+            2026.10.19 type ISREPFN added (item set report function)
+            2026.10.19 function tas_ptsize added (prefix tree size)
 ----------------------------------------------------------------------*/
 #ifndef __TRACT__
 #define __TRACT__
+#include <limits.h>
 #ifndef NIMAPFN
 #define NIMAPFN
 #endif
@@ -48,25 +56,62 @@
 #define E_UNKAPP   (-19)        /* unknown appearance indicator */
 #define E_FLDCNT   (-20)        /* too many fields */
 
+/* --- support values --- */
+#if LONG_MAX > 0x7fffffffL      /* if long has 64 bits */
+#define SUPP_MAX    LONG_MAX    /* maximal support value */
+#define SUPP_FMT    "%ld"       /* printf format for a support */
+#elif defined _MSC_VER          /* if Microsoft compiler */
+#define SUPP_MAX    _I64_MAX
+#define SUPP_FMT    "%I64d"
+#elif defined __GNUC__          /* if GNU compiler */
+#define SUPP_MAX    (__extension__ 0x7fffffffffffffffLL)
+#define SUPP_FMT    "%lld"
+#else                           /* if no 64 bit type is known */
+#define SUPP_MAX    LONG_MAX
+#define SUPP_FMT    "%ld"
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
+#if LONG_MAX > 0x7fffffffL      /* --- a support value --- */
+typedef long SUPP;              /* (transaction or item set count) */
+#elif defined _MSC_VER
+typedef __int64 SUPP;
+#elif defined __GNUC__
+__extension__ typedef long long SUPP;
+#else
+typedef long SUPP;
+#endif
+
 typedef struct {                /* --- an item --- */
   int     id;                   /* item identifier */
-  int     frq;                  /* frequency in transactions */
-  int     xfq;                  /* extended frequency (t.a. sizes) */
+  SUPP    frq;                  /* frequency in transactions */
+  SUPP    xfq;                  /* extended frequency (t.a. sizes) */
   int     app;                  /* appearance indicator */
 } ITEM;                         /* (item) */
 
+typedef struct {                /* --- a pair of items --- */
+  int     a, b;                 /* item identifiers (a < b, -1: empty) */
+  SUPP    frq;                  /* frequency in transactions */
+} ITEMPAIR;                     /* (item pair) */
+
 typedef struct {                /* --- an item set --- */
   NIMAP   *nimap;               /* name/identifier map */
   TABSCAN *tscan;               /* table scanner */
   char    chars[4];             /* special characters */
-  int     tac;                  /* transaction counter */
+  SUPP    tac;                  /* transaction counter */
   int     app;                  /* default appearance indicator */
   int     vsz;                  /* size of transaction buffer */
   int     cnt;                  /* number of items in transaction */
   int     *items;               /* items in transaction */
+  int     psz;                  /* size of pair hash table */
+  int     pcnt;                 /* number of different pairs */
+  int     pfix;                 /* whether pair data has been recoded */
+  ITEMPAIR *pairs;              /* pair counters (hash table) */
+  int     bsz;                  /* number of hash buckets for pairs */
+  SUPP    *bkts;                /* pair hash bucket counters (DHP) */
+  int     *raw;                 /* map from item codes to raw ids */
 } ITEMSET;                      /* (item set) */
 
 typedef struct {                /* --- an item set evaluator --- */
@@ -99,11 +144,21 @@ typedef struct {                /* --- a transaction set --- */
 
 typedef struct _tatree {        /* --- a transaction tree (node) --- */
   int     cnt;                  /* number of transactions */
+                                /* (at most tas_cnt(), so int) */
   int     max;                  /* size of largest transaction */
   int     size;                 /* node size (number of children) */
   int     items[1];             /* next items in rep. transactions */
 } TATREE;                       /* (transaction tree) */
 
+/* A node with a negative size is a path node: the -size items are    */
+/* contained in all transactions of the node. If some transactions    */
+/* are longer (max > -size), a pointer to the subtree representing    */
+/* the rest of these transactions follows the items (see tat_tail).   */
+
+typedef int ISREPFN (const int *set, int cnt, SUPP supp, void *data);
+/* function to report a found item set (items in ascending order); */
+/* a negative result aborts the search that reports the item sets */
+
 /*----------------------------------------------------------------------
   Item Set Functions
 ----------------------------------------------------------------------*/
@@ -119,22 +174,27 @@ extern int         is_cnt     (ITEMSET *iset);
 extern int         is_item    (ITEMSET *iset, const char *name);
 extern const char* is_name    (ITEMSET *iset, int item);
 
-extern int         is_gettac  (ITEMSET *iset);
-extern int         is_settac  (ITEMSET *iset, int cnt);
-extern int         is_addtac  (ITEMSET *iset, int cnt);
-extern int         is_getfrq  (ITEMSET *iset, int item);
-extern int         is_setfrq  (ITEMSET *iset, int item, int frq);
-extern int         is_addfrq  (ITEMSET *iset, int item, int frq);
-extern int         is_getxfq  (ITEMSET *iset, int item);
-extern int         is_setxfq  (ITEMSET *iset, int item, int frq);
+extern SUPP        is_gettac  (ITEMSET *iset);
+extern SUPP        is_settac  (ITEMSET *iset, SUPP cnt);
+extern SUPP        is_addtac  (ITEMSET *iset, SUPP cnt);
+extern SUPP        is_getfrq  (ITEMSET *iset, int item);
+extern SUPP        is_setfrq  (ITEMSET *iset, int item, SUPP frq);
+extern SUPP        is_addfrq  (ITEMSET *iset, int item, SUPP frq);
+extern SUPP        is_getxfq  (ITEMSET *iset, int item);
+extern SUPP        is_setxfq  (ITEMSET *iset, int item, SUPP frq);
 extern int         is_getapp  (ITEMSET *iset, int item);
 extern int         is_setapp  (ITEMSET *iset, int item, int app);
 
 extern int         is_readapp (ITEMSET *iset, FILE *file);
+extern int         is_pairs   (ITEMSET *iset);
 extern int         is_read    (ITEMSET *iset, FILE *file);
+extern SUPP        is_getpfq  (ITEMSET *iset, int a, int b);
+extern int         is_dhp     (ITEMSET *iset, int size);
+extern SUPP        is_getbfq  (ITEMSET *iset, int a, int b);
 
-extern int         is_recode  (ITEMSET *iset, int minfrq,
+extern int         is_recode  (ITEMSET *iset, SUPP minfrq,
                                int dir, int *map);
+extern void        is_remap   (ITEMSET *iset, const int *map);
 extern void        is_trunc   (ITEMSET *iset, int cnt);
 extern int         is_filter  (ITEMSET *iset, const char *marks);
 extern int         is_tsize   (ITEMSET *iset);
@@ -143,7 +203,7 @@ extern int*        is_tract   (ITEMSET *iset);
 /*----------------------------------------------------------------------
   Item Set Evaluation Functions
 ----------------------------------------------------------------------*/
-extern ISEVAL*     ise_create (ITEMSET *iset, int tacnt);
+extern ISEVAL*     ise_create (ITEMSET *iset, SUPP tacnt);
 extern void        ise_delete (ISEVAL *eval);
 extern double      ise_eval   (ISEVAL *eval, int *ids, int cnt, int pre,
                                double supp);
@@ -182,6 +242,7 @@ extern int         tas_filter  (TASET *taset, const char *marks);
 extern void        tas_shuffle (TASET *taset, double randfn(void));
 extern void        tas_sort    (TASET *taset, int heap);
 extern int         tas_occur   (TASET *taset, const int *items, int n);
+extern int         tas_ptsize  (TASET *taset);
 
 #ifndef NDEBUG
 extern void        tas_show    (TASET *taset);
@@ -198,6 +259,7 @@ extern int         tat_size    (TATREE *tat);
 extern int*        tat_items   (TATREE *tat);
 extern int         tat_item    (TATREE *tat, int index);
 extern TATREE*     tat_child   (TATREE *tat, int index);
+extern TATREE*     tat_tail    (TATREE *tat);
 extern void        tat_mark    (TATREE *tat);
 
 #ifndef NDEBUG
@@ -256,6 +318,8 @@ extern void        tat_show    (TATREE *tat);
 #define tat_items(t)      ((t)->items)
 #ifndef ARCH64
 #define tat_child(t,i)    (((TATREE**)((t)->items +(t)->size))[i])
+#define tat_tail(t)       (((t)->max > -(t)->size) \
+                          ? *(TATREE**)((t)->items -(t)->size) : NULL)
 #endif
 
 #endif
@@ -11,7 +11,14 @@ $objs = ["#{apriori_root}/util/src/vecops.o",
          "#{apriori_root}/math/src/gamma.o",
          "#{apriori_root}/math/src/chi2.o", 
          "#{apriori_root}/apriori/src/tract.o",
+         "#{apriori_root}/apriori/src/hshtree.o",
          "#{apriori_root}/apriori/src/istree.o",
+         "#{apriori_root}/apriori/src/setrepo.o",
+         "#{apriori_root}/apriori/src/fpgrowth.o",
+         "#{apriori_root}/apriori/src/eclat.o",
+         "#{apriori_root}/apriori/src/lcm.o",
+         "#{apriori_root}/apriori/src/genmax.o",
+         "#{apriori_root}/apriori/src/parmine.o",
          "apriori_wrapper.o",
          "Apriori.o"]
 
@@ -22,6 +29,9 @@ $CPPFLAGS = " -I#{apriori_root}/util/src -I#{apriori_root}/math/src -I#{apriori_
 # gcc -I. -I/usr/local/lib/ruby/1.8/i686-darwin8.10.1 -I/usr/local/lib/ruby/1.8/i686-darwin8.10.1 -I.  -fno-common -g -O2 -pipe -fno-common  -c Apriori.c
 # gcc -I. -I/usr/local/lib/ruby/1.8/i686-darwin8.10.1 -I/usr/local/lib/ruby/1.8/i686-darwin8.10.1 -I.  -fno-common -g -O2 -pipe -fno-common  -c apriori_wrapper.c
 
+# Parallel support counting and mining need pthreads (-T/-M options)
+$CPPFLAGS += " -DNOTHREADS " unless have_library('pthread')
+
 # Give it a name
 extension_name = 'apriori_ext'
 
@@ -3,3 +3,73 @@ require 'pp'
 require File.dirname(__FILE__) + '/../lib/apriori'
 
 FIXTURES_DIR = File.expand_path(File.dirname(__FILE__) + "/fixtures")
+
+# Helpers for the tests of the search and counting options: they write
+# generated transactions to temporary files and run the program on them
+# in a child process (so that a failing run or a memory limit does not
+# affect the tests, and errors are seen as the exit status).
+module AprioriRunner
+  require 'tempfile'
+
+  private
+
+  # write random transactions over +items+ items to a temporary file
+  def transactions_file(count, items, sizes, seed=1)
+    rand = Random.new(seed)
+    lines_file((1..count).map do
+      size = rand.rand(sizes)
+      (0...items).to_a.sample(size, random: rand).sort.map { |i| "i#{i}" }.join(" ")
+    end)
+  end
+
+  # write the given lines to a temporary file
+  def lines_file(lines)
+    file = Tempfile.new("apriori")
+    file.puts lines
+    file.close
+    (@files ||= []) << file
+    file.path
+  end
+
+  # write an appearances file with the given lines
+  def app_file(*lines)
+    lines_file(lines)
+  end
+
+  def remove_files
+    (@files || []).each { |f| f.close! }
+  end
+
+  # run the program and return the output lines (as written) and the
+  # exit status; +limit+ restricts the additional data memory (bytes)
+  def apriori_output(options, input, app=nil, limit=nil)
+    out = lines_file([])
+    args = ["apriori"] + options + [input, out] + (app ? [app] : [])
+    pid = fork do
+      STDERR.reopen(File::NULL)
+      if limit
+        data = File.read("/proc/self/status")[/VmData:\s*(\d+)/, 1].to_i
+        Process.setrlimit(Process::RLIMIT_DATA, data *1024 +limit)
+      end
+      do_apriori(args)
+      exit!(0)
+    end
+    Process.wait(pid)
+    [File.readlines(out).map { |l| l.chomp }, $?.exitstatus]
+  end
+
+  # run the program and return its output in a normalized form: the
+  # items of a set or rule body are sorted (their order depends on the
+  # algorithm) and so are the lines
+  def run_apriori(options, input, app=nil, limit=nil)
+    lines, status = apriori_output(options, input, app, limit)
+    assert_equal 0, status, "apriori #{options.join(' ')} failed"
+    lines.map do |line|
+      items, values = line.split(" (", 2)
+      head, body = items.split(" <- ", 2)
+      items = body ? "#{head} <- #{body.split.sort.join(' ')}" : head.split.sort.join(' ')
+      values ? "#{items} (#{values}" : items
+    end.sort
+  end
+
+end
@@ -0,0 +1,253 @@
+require File.dirname(__FILE__) + '/../test_helper.rb'
+
+# The options that change how the supports are counted (threads, data
+# structures, pair counting) must not change what is found: each test
+# compares the output with that of the default (or a plainer) setting.
+class TestCountingOptions < Test::Unit::TestCase
+  include Apriori
+  include AprioriRunner
+
+  def teardown
+    remove_files
+  end
+
+  # transactions that share no long prefix end in long single child
+  # runs of the transaction tree, which are stored as path nodes
+  def test_path_nodes
+    input = transactions_file(200, 60, 20..40)
+    %w{-ts -tr -tc}.each do |target|
+      assert_equal run_apriori([target, "-s20", "-c50", "-h"], input),
+                   run_apriori([target, "-s20", "-c50"], input),
+                   "#{target} with path nodes finds other sets/rules"
+    end
+  end
+
+  # counting with several threads, in per-thread counter shadows (-T4)
+  # or with atomic increments of shared counters (-T-4), on the
+  # transaction tree and on the plain transactions (-h)
+  def test_parallel_counting
+    inputs = [File.join(FIXTURES_DIR, "sample.txt"),
+              File.join(FIXTURES_DIR, "market_basket_string_test.txt"),
+              transactions_file(2000, 50, 3..12)]
+    inputs.each do |input|
+      %w{-ts -tr}.each do |target|
+        expected = run_apriori([target, "-s1", "-c50"], input)
+        [%w{-T4}, %w{-T-4}, %w{-T4 -h}].each do |options|
+          assert_equal expected, run_apriori([target, "-s1", "-c50"] + options, input),
+                       "#{target} #{options.join(' ')} differs on #{File.basename(input)}"
+        end
+      end
+    end
+  end
+
+  # counting only in shared counters with atomic increments (-T-n),
+  # with threads that steal work packages from each other (more
+  # packages than threads, of very different sizes)
+  def test_atomic_counting
+    input = lines_file((1..3000).map do |i|
+      size = (i % 7 == 0) ? 40 : 4    # some long transactions
+      (0...size).map { |k| "i#{(i*k + k*k) % 60}" }.uniq.join(" ")
+    end)
+    %w{-ts -tr}.each do |target|
+      expected = run_apriori([target, "-s2", "-c50"], input)
+      [%w{-T-1}, %w{-T-2}, %w{-T-3 -h}, %w{-T-8}, %w{-T-8 -h}].each do |options|
+        assert_equal expected, run_apriori([target, "-s2", "-c50"] + options, input),
+                     "#{target} #{options.join(' ')} finds other sets/rules"
+      end
+    end
+  end
+
+  # with -z, sparse nodes get identifier maps; with the items in
+  # descending order of frequency (-q-1) the nodes below two "hub"
+  # items get maps of up to 16 (-s2.8, linear search) or of 17 to 63
+  # items (-s2.6, bisection), in which the transaction items are sought
+  def test_identifier_maps
+    input = hubs_file
+    %w{-s2.6 -s2.8}.each do |supp|
+      expected = run_apriori(["-ts", "-q-1", supp], input)
+      [%w{-z}, %w{-z -h}, %w{-z -T2}].each do |options|
+        assert_equal expected, run_apriori(["-ts", "-q-1", supp] + options, input),
+                     "#{supp} #{options.join(' ')} finds other item sets"
+      end
+    end
+  end
+
+  # at -s2.4 the identifier maps below the hub items hold 64 or more
+  # items, so a blocked search index is built for them
+  def test_map_search_index
+    input = hubs_file
+    %w{-ts -tr -tc}.each do |target|
+      expected = run_apriori([target, "-q-1", "-s2.4"], input)
+      [%w{-z}, %w{-z -h}, %w{-z -T-2}].each do |options|
+        assert_equal expected, run_apriori([target, "-q-1", "-s2.4"] + options, input),
+                     "#{target} #{options.join(' ')} finds other sets/rules"
+      end
+    end
+  end
+
+  # the nodes of each level of the item set tree are allocated from an
+  # arena of that level; a deep tree with pure counter vectors and
+  # identifier maps (-z) and with optimistic levels (-L2) must give
+  # the same sets as FP-growth, which does not use the tree
+  def test_level_arenas
+    input = transactions_file(300, 30, 10..20)
+    expected = run_apriori(%w{-ts -s10 -Af}, input)
+    [[], %w{-z}, %w{-L2}, %w{-z -L3 -h}].each do |options|
+      assert_equal expected, run_apriori(%w{-ts -s10} + options, input),
+                   "#{options.join(' ')} finds other item sets"
+    end
+  end
+
+  # the counter width follows from the number of transactions: 16 bit
+  # counters for up to 32767 transactions, 32 bit counters for more;
+  # -W32 and -W64 enforce wider counters (64 bit counters are chosen
+  # automatically only for more than INT_MAX transactions)
+  def test_counter_widths
+    [32767, 32768].each do |count|
+      trans = (0...count).map do |i|
+        ["a", i % 4 != 0 ? "b" : nil, i.even? ? "c" : nil,
+         i % 3 == 0 ? "d" : nil].compact
+      end
+      input = lines_file(trans.map { |t| t.join(" ") })
+      expected = {}
+      (1..4).each do |size|
+        %w{a b c d}.combination(size) do |set|
+          expected[set.join(" ")] = trans.count { |t| (set - t).empty? }
+        end
+      end
+      [[], %w{-W32}, %w{-W64}, %w{-W64 -T-2}, %w{-W64 -h -T2}].each do |options|
+        found = run_apriori(%w{-ts -s0 -a} + options, input)
+        assert_equal expected, supports(found),
+                     "#{options.join(' ')} gives other supports (#{count} transactions)"
+      end
+    end
+  end
+
+  # the absolute supports reported (option -a) are the numbers of
+  # transactions that contain the sets, also when summed up from the
+  # counters of several threads or in 64 bit counters
+  def test_absolute_supports
+    input = transactions_file(2000, 40, 3..10)
+    trans = File.readlines(input).map { |l| l.split }
+    [[], %w{-T4}, %w{-T-4}, %w{-W64 -T4}, %w{-W64 -T-4 -h}].each do |options|
+      found = supports(run_apriori(%w{-ts -s2 -a} + options, input))
+      assert !found.empty?
+      found.each do |set, supp|
+        assert_equal trans.count { |t| (set.split - t).empty? }, supp,
+                     "#{options.join(' ')} gives a wrong support of #{set}"
+      end
+    end
+  end
+
+  # counting the candidates in a hash tree (-H) instead of in the item
+  # set tree, also on the plain transactions (-h)
+  def test_hash_tree
+    inputs = [File.join(FIXTURES_DIR, "market_basket_string_test.txt"),
+              transactions_file(1000, 40, 3..12)]
+    inputs.each do |input|
+      %w{-ts -tr -tm}.each do |target|
+        expected = run_apriori([target, "-s2", "-c20"], input)
+        [%w{-H}, %w{-H -h}].each do |options|
+          assert_equal expected, run_apriori([target, "-s2", "-c20"] + options, input),
+                       "#{target} #{options.join(' ')} differs on #{File.basename(input)}"
+        end
+      end
+    end
+  end
+
+  # counting the item pairs in a triangular array (-P), also for rules
+  # with head only items (which must not occur together in a pair)
+  def test_pair_array
+    input = transactions_file(1000, 40, 3..12)
+    heads = app_file("both", "i2 h", "i3 h", "i7 h", "i5 n")
+    [%w{-ts}, %w{-tr -c20}, %w{-tm}].each do |options|
+      assert_equal run_apriori(options + %w{-s2}, input),
+                   run_apriori(options + %w{-s2 -P}, input),
+                   "#{options.join(' ')} -P finds other sets/rules"
+    end
+    [%w{-ts}, %w{-tr -c20}].each do |options|
+      expected = run_apriori(options + %w{-s2}, input, heads)
+      assert expected.none? { |l| (l.split & %w{i2 i3 i7}).size > 1 }
+      assert_equal expected, run_apriori(options + %w{-s2 -P}, input, heads),
+                   "#{options.join(' ')} -P finds other sets/rules with head only items"
+    end
+  end
+
+  # counting the item pairs while the transactions are read (-F), into
+  # the item set tree or into the triangular array (-F -P)
+  def test_fused_pair_counting
+    input = transactions_file(1000, 40, 3..12)
+    [%w{-ts}, %w{-tr -c20}, %w{-tc}].each do |options|
+      expected = run_apriori(options + %w{-s2}, input)
+      [%w{-F}, %w{-F -P}, %w{-F -T4}].each do |more|
+        assert_equal expected, run_apriori(options + %w{-s2} + more, input),
+                     "#{(options + more).join(' ')} finds other sets/rules"
+      end
+    end
+  end
+
+  # filtering the candidate pairs with hashed pair counts (-D): with
+  # few buckets (many collisions) only fewer pairs are filtered, but
+  # no frequent pair may be lost
+  def test_pair_hash_filter
+    input = transactions_file(1000, 40, 3..12)
+    [%w{-ts}, %w{-tr -c20}].each do |options|
+      expected = run_apriori(options + %w{-s2}, input)
+      [%w{-D64}, %w{-D4096}, %w{-D64 -P}, %w{-D4096 -h}].each do |more|
+        assert_equal expected, run_apriori(options + %w{-s2} + more, input),
+                     "#{(options + more).join(' ')} finds other sets/rules"
+      end
+    end
+  end
+
+  # recoding the items that occur in frequent pairs after the pairs
+  # were counted (-R), which removes the other items from the tree
+  def test_item_recoding
+    input = transactions_file(1000, 60, 2..8)
+    heads = app_file("both", "i2 h", "i3 h", "i7 h", "i5 n")
+    [%w{-ts}, %w{-tr -c20}, %w{-tc}].each do |options|
+      expected = run_apriori(options + %w{-s1.2}, input)
+      [%w{-R}, %w{-R -P}, %w{-R -h}, %w{-R -T4}].each do |more|
+        assert_equal expected, run_apriori(options + %w{-s1.2} + more, input),
+                     "#{(options + more).join(' ')} finds other sets/rules"
+      end
+    end
+    assert_equal run_apriori(%w{-tr -c20 -s1.2}, input, heads),
+                 run_apriori(%w{-tr -c20 -s1.2 -R}, input, heads),
+                 "-tr -R finds other rules with head only items"
+  end
+
+  # counting the later levels with lists of candidate identifiers per
+  # transaction (-I), also starting from the plain transactions (-h)
+  # and after recoding the used items (-R)
+  def test_candidate_id_lists
+    { transactions_file(500, 20, 5..12) => "-s3",
+      transactions_file(1000, 40, 3..12) => "-s1" }.each do |input, supp|
+      [%w{-ts}, %w{-tr -c20}, %w{-tc}].each do |options|
+        expected = run_apriori(options + [supp], input)
+        [%w{-I}, %w{-I -h}, %w{-R -I}, %w{-I -T4}].each do |more|
+          assert_equal expected, run_apriori(options + [supp] + more, input),
+                       "#{(options + more).join(' ')} finds other sets/rules"
+        end
+      end
+    end
+  end
+
+  private
+
+  # get the absolute supports of the found sets (option -a)
+  def supports(lines)
+    Hash[lines.map { |l| [l[/^[^(]*/].strip, l[/\/(\d+)\)$/, 1].to_i] }]
+  end
+
+  # write transactions of 10 random items out of 300 to which each
+  # of four hub items is added with probability 0.7
+  def hubs_file
+    rand = Random.new(3)
+    lines_file((1..3000).map do
+      hubs = (0..3).select { rand.rand < 0.7 }.map { |h| "h#{h}" }
+      (hubs + (0...300).to_a.sample(10, random: rand).map { |i| "i#{i}" }).join(" ")
+    end)
+  end
+
+end
@@ -0,0 +1,279 @@
+require File.dirname(__FILE__) + '/../test_helper.rb'
+
+class TestSearchOptions < Test::Unit::TestCase
+  include Apriori
+  include AprioriRunner
+
+  def setup
+    @sparse = transactions_file(2000, 200, 5..15)
+    @dense  = transactions_file(500, 20, 5..12)
+    @heads  = app_file("both", "i2 h", "i3 h", "i7 h", "i5 n")
+  end
+
+  def teardown
+    remove_files
+  end
+
+  # counting several levels per pass (-L) must not create the candidates
+  # of all subsets of the frequent items: levels are only added
+  # optimistically after the pairs were counted, and not if they would
+  # need more than twice the counters of the level below (otherwise -L3
+  # needs about 200MB on this data, and -L4 does not finish)
+  def test_combined_passes_stay_small
+    sets = run_apriori(%w{-ts -s1 -u0 -L1}, @sparse)
+    [2, 3, 4, 8].each do |levels|
+      found = run_apriori(%W{-ts -s1 -u0 -L#{levels}}, @sparse, nil, 32 << 20)
+      assert_equal sets, found, "-L#{levels} finds other item sets"
+    end
+  end
+
+  # the candidates of a new level are generated by several threads if
+  # there are enough of them (here for the levels 3 and 4); the result
+  # must be the same as with a single thread
+  def test_parallel_generation
+    %w{-ts -tr}.each do |target|
+      expected = run_apriori([target, "-s0.2", "-c10"], @sparse)
+      [%w{-T4}, %w{-T-4}, %w{-T4 -L2}].each do |options|
+        assert_equal expected, run_apriori([target, "-s0.2", "-c10"] + options, @sparse),
+                     "#{target} #{options.join(' ')} finds other sets/rules"
+      end
+    end
+  end
+
+  # FP-growth (-Af) finds the same sets and rules as the level-wise
+  # search, for all targets that are extracted from the item set tree
+  # (for rules only the sets with the support of the tree are mined,
+  # not all with the support times the confidence, which needs 700MB)
+  def test_fpgrowth
+    { @dense => "-s3", @sparse => "-s0.2" }.each do |input, supp|
+      [%w{-ts}, %w{-tr -c20}, %w{-tc}, %w{-tm}, %w{-tr -c20 -n3}].each do |options|
+        assert_equal run_apriori(options + [supp], input),
+                     run_apriori(options + [supp, "-Af"], input, nil, 64 << 20),
+                     "#{options.join(' ')} -Af finds other sets/rules"
+      end
+    end
+  end
+
+  # eclat (-Ae) finds the same sets and rules as the level-wise search;
+  # on the dense data it switches from tid-lists to diffsets
+  def test_eclat
+    { @dense => "-s3", @sparse => "-s0.2" }.each do |input, supp|
+      [%w{-ts}, %w{-tr -c20}, %w{-tc}, %w{-tm}, %w{-ts -m3 -n4}].each do |options|
+        assert_equal run_apriori(options + [supp], input),
+                     run_apriori(options + [supp, "-Ae"], input),
+                     "#{options.join(' ')} -Ae finds other sets/rules"
+      end
+    end
+  end
+
+  # closed item sets found directly with LCM (-tc with -Af or -Ae), on
+  # data in which only few of the frequent sets are closed; with a
+  # maximal set size (-n) the sets are filtered in the item set tree
+  def test_closed_sets
+    [blocks_file, @dense].each do |input|
+      [%w{-tc -s1}, %w{-tc -s1 -m3}, %w{-tc -s1 -n4}].each do |options|
+        expected = run_apriori(options, input)
+        [%w{-Af}, %w{-Ae}].each do |algo|
+          assert_equal expected, run_apriori(options + algo, input),
+                       "#{(options + algo).join(' ')} finds other closed sets"
+        end
+      end
+    end
+  end
+
+  # maximal item sets found directly with GenMax (-tm with -Af or -Ae),
+  # also with a minimal set size (-m); with a maximal set size (-n) the
+  # sets are filtered in the item set tree
+  def test_maximal_sets
+    [blocks_file, @dense].each do |input|
+      [%w{-tm -s1}, %w{-tm -s1 -m3}, %w{-tm -s1 -n4}].each do |options|
+        expected = run_apriori(options, input)
+        [%w{-Af}, %w{-Ae}].each do |algo|
+          assert_equal expected, run_apriori(options + algo, input),
+                       "#{(options + algo).join(' ')} finds other maximal sets"
+        end
+      end
+    end
+  end
+
+  # a top k search (-K) finds the sets/rules that have at least the
+  # support of the k-th best one (so there may be more than k of them
+  # if several have this support); the minimal support is found while
+  # searching, unless one is given with -s (then the k best of the
+  # sets/rules with this support are found)
+  def test_top_k
+    input = transactions_file(1000, 40, 3..12)
+    [[%w{-ts}, "-s1", "-s5", 100],
+     [%w{-tr -m2 -c50}, "-s0.5", "-s1", 20]].each do |options, low, high, k|
+      all = run_apriori(options + [low, "-a"], input)
+      [1, 5, 20, 100].each do |n|
+        expected = top(all, n)
+        assert expected.size >= n
+        assert_equal expected, run_apriori(options + %W{-K#{n} -a}, input),
+                     "#{options.join(' ')} -K#{n} finds other sets/rules"
+      end
+      expected = top(run_apriori(options + [high, "-a"], input), k)
+      assert_not_equal top(all, k), expected
+      assert_equal expected, run_apriori(options + %W{-K#{k} #{high} -a}, input),
+                   "#{options.join(' ')} -K#{k} #{high} finds other sets/rules"
+    end
+  end
+
+  # an automatic choice of the algorithm and options (-X) must not
+  # change the result; on the block data it chooses FP-growth (which
+  # reports the sets in another order), but it keeps an explicitly
+  # given algorithm and the options that need the given algorithm
+  def test_automatic_choice
+    blocks = blocks_file
+    { blocks => "-s3", @dense => "-s1", @sparse => "-s0.2" }.each do |input, supp|
+      [%w{-ts}, %w{-tr -c50 -n3}, %w{-tc}].each do |options|
+        assert_equal run_apriori(options + [supp], input),
+                     run_apriori(options + [supp, "-X"], input),
+                     "#{options.join(' ')} -X finds other sets/rules"
+      end
+    end
+    assert_equal apriori_output(%w{-ts -s3 -Af}, blocks),
+                 apriori_output(%w{-ts -s3 -X}, blocks)
+    [%w{-Aa}, %w{-Ae}, %w{-I}, %w{-T2}, %w{-T-2}, %w{-M2}].each do |options|
+      assert_equal apriori_output(%w{-ts -s3} + options, blocks),
+                   apriori_output(%w{-ts -s3 -X} + options, blocks),
+                   "-X does not keep #{options.join(' ')}"
+    end
+  end
+
+  # mining the projections to the frequent items in parallel (-M) with
+  # each of the algorithms; the sets are reported in item order, so the
+  # output does not depend on the number of threads
+  def test_parallel_projections
+    { @dense => "-s3", @sparse => "-s0.2" }.each do |input, supp|
+      [%w{-ts}, %w{-tr -c20}, %w{-tc}, %w{-tm}].each do |options|
+        expected = run_apriori(options + [supp], input)
+        [%w{-M1}, %w{-M4}, %w{-M4 -Af}, %w{-M3 -Ae}].each do |more|
+          assert_equal expected, run_apriori(options + [supp] + more, input),
+                       "#{(options + more).join(' ')} finds other sets/rules"
+        end
+      end
+      %w{-Aa -Af -Ae}.each do |algo|
+        assert_equal apriori_output(["-ts", supp, algo, "-M1"], input),
+                     apriori_output(["-ts", supp, algo, "-M4"], input)
+      end
+    end
+  end
+
+  # class association rules (-Z): the head only items are the classes
+  # and all other items may only appear in rule bodies, which is the
+  # same as marking them as body only in the appearances file (but
+  # allows to prune body sets that cannot reach any class)
+  def test_class_rules
+    rand = Random.new(7)
+    input = lines_file(File.readlines(@dense).map do |line|
+      items = line.split
+      cls = items.include?("i3") ? rand.rand(2) : rand.rand(3)
+      (items + ["c#{cls}"]).join(" ")
+    end)
+    classes = app_file("both", "c0 h", "c1 h", "c2 h")
+    bodies  = app_file("in", "c0 h", "c1 h", "c2 h")
+    [%w{-s2 -c40}, %w{-s2 -c60 -o}, %w{-s1 -c50 -m3}, %w{-s2 -c40 -L3},
+     %w{-s2 -c40 -T4}, %w{-s2 -c40 -Af}, %w{-c40 -K20}].each do |options|
+      expected = run_apriori(%w{-tr} + options, input, bodies)
+      assert !expected.empty?
+      assert_equal expected, run_apriori(%w{-tr -Z} + options, input, classes),
+                   "-tr -Z #{options.join(' ')} finds other rules"
+    end
+    # without target r or without classes the program exits with E_CARS
+    assert_equal (-23) & 0xff, apriori_output(%w{-ts -Z}, input, classes).last
+    assert_equal (-23) & 0xff, apriori_output(%w{-tr -Z}, input).last
+  end
+
+  # contrast sets (-te): the group supports must be those of the sets
+  # in the transactions of each group, and a set must be frequent in a
+  # group (as found by a run on the group alone) and have at least the
+  # minimal growth rate (-G) times the relative support in the other
+  def test_contrast_sets
+    rand = Random.new(9)
+    groups = { "g1" => [], "g2" => [] }
+    File.readlines(@dense).each do |line|
+      items = line.split
+      p1 = items.include?("i3") ? 0.8 : 0.3
+      groups[rand.rand < p1 ? "g1" : "g2"] << items
+    end
+    input  = lines_file(groups.flat_map do |g, ts|
+      ts.map { |t| (t + [g]).join(" ") }
+    end)
+    labels = app_file("both", "g1 h", "g2 h")
+    freq = {}
+    groups.each do |g, ts|
+      sets = run_apriori(%w{-ts -s5}, lines_file(ts.map { |t| t.join(" ") }))
+      freq[g] = sets.map { |l| l[/^[^(]*/].strip }
+    end
+    counts = lambda do |set|
+      groups.values.map { |ts| ts.count { |t| (set.split - t).empty? } }
+    end
+    n1, n2 = groups.values.map { |ts| ts.size.to_f }
+    [[%w{-G2}, 2], [%w{-G3}, 3], [%w{-G2 -h -T2}, 2]].each do |options, grow|
+      found = run_apriori(%w{-te -s5 -a} + options, input, labels)
+      assert !found.empty?
+      found = Hash[found.map do |l|
+        [l[/^[^(]*/].strip, l.scan(/\/(\d+)/).flatten.map { |c| c.to_i }]
+      end]
+      found.each do |set, supps|
+        assert_equal counts.call(set), supps, "wrong group supports of #{set}"
+      end
+      expected = (freq["g1"] + freq["g2"]).uniq.select do |set|
+        c1, c2 = counts.call(set)
+        (freq["g1"].include?(set) && c1/n1 >= grow *c2/n2) ||
+        (freq["g2"].include?(set) && c2/n2 >= grow *c1/n1)
+      end
+      assert_equal expected.sort, found.keys.sort,
+                   "-te #{options.join(' ')} finds other contrast sets"
+    end
+    # other than two group labels or another algorithm: E_CONTR
+    three = app_file("both", "g1 h", "g2 h", "i3 h")
+    assert_equal (-25) & 0xff, apriori_output(%w{-te -s5}, input, three).last
+    assert_equal (-25) & 0xff, apriori_output(%w{-te -s5 -Af}, input, labels).last
+  end
+
+  # an item set may contain at most one head only item (and no items
+  # to ignore), regardless of the algorithm that is used to find it
+  # (closed and maximal sets are closed and maximal w.r.t. the sets
+  # that respect this)
+  def test_head_only_items
+    sets = Hash.new do |h, target|
+      h[target] = run_apriori([target] + %w{-s5 -Aa}, @dense, @heads)
+    end
+    assert sets["-ts"].none? { |s| (s.split & %w{i2 i3 i7}).size > 1 }
+    assert sets["-ts"].none? { |s| s.split.include?("i5") }
+    [%w{-ts -Af}, %w{-ts -Ae}, %w{-tc -Af}, %w{-tc -Ae},
+     %w{-tm -Af}, %w{-tm -Ae}, %w{-ts -M3}, %w{-ts -M2 -Af},
+     %w{-tc -M3}].each do |options|
+      found = run_apriori(options + %w{-s5}, @dense, @heads)
+      assert_equal sets[options.first], found,
+                   "#{options.join(' ')} finds other item sets"
+    end
+  end
+
+  private
+
+  # get the absolute support of a set or rule (option -a)
+  def abs_supp(line)
+    line[/\/(\d+)[,)]/, 1].to_i
+  end
+
+  # get the sets/rules with at least the k-th best support
+  def top(lines, k)
+    cut = lines.map { |l| abs_supp(l) }.sort.reverse[k-1] || 0
+    lines.select { |l| abs_supp(l) >= cut }
+  end
+
+  # write transactions that each contain all items of one of a few
+  # blocks (and two other items), so that few sets are closed
+  def blocks_file
+    rand = Random.new(5)
+    lines_file((1..600).map do
+      block = rand.rand(6)
+      items = (0...12).map { |i| "b#{block}_#{i}" }
+      (items + (0...40).to_a.sample(2, random: rand).map { |i| "n#{i}" }).join(" ")
+    end)
+  end
+
+end